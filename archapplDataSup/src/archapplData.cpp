@@ -25,6 +25,8 @@
  */
 
 #include <cfloat>
+#include <cstring>
+#include <cstdlib>
 #include "archapplProto.pb.h"
 
 #define epicsExportSharedSymbols
@@ -50,164 +52,209 @@ namespace ArchapplData {
       }
    }
 
-   void unescapePBData(std::vector<char> *pbData, std::vector< std::vector<char> > &unescapedLines)
+   // As serialized PB messages are binary data; after serialization, newline characters are escaped
+   // to maintain a "sample per line" constraint:
+   // 1. The ASCII escape character 0x1B is escaped to the following two characters 0x1B 0x01
+   // 2. The ASCII newline character \n or 0x0A is escaped to the following two characters 0x1B 0x02
+   // 3. The ASCII carriage return character 0x0D is escaped to the following two characters 0x1B 0x03
+   //
+   const char ESCAPE_CHAR = 0x1B;
+   const char ESCAPE_ESCAPE_CHAR = 0x01;
+   const char NEWLINE_CHAR = 0x0A;
+   const char NEWLINE_ESCAPE_CHAR = 0x02;
+   const char CARRIAGERETURN_CHAR = 0x0D;
+   const char CARRIAGERETURN_ESCAPE_CHAR = 0x03;
+
+   // To successfully parse deserialize the data we have to remove the escaping. Every time we find 0x1B
+   // we know that this is an exaped character and is should be replaced by the character that follows.
+   // As the unescaped line is never longer than the escaped line this is done in place.
+   // Returns the unescaped line length.
+   //
+   static size_t unescapeLine(char *line, size_t lineLength)
    {
-      // As serialized PB messages are binary data; after serialization, newline characters are escaped
-      // to maintain a "sample per line" constraint:
-      // 1. The ASCII escape character 0x1B is escaped to the following two characters 0x1B 0x01
-      // 2. The ASCII newline character \n or 0x0A is escaped to the following two characters 0x1B 0x02
-      // 3. The ASCII carriage return character 0x0D is escaped to the following two characters 0x1B 0x03
-      //
-      // To successfully parse deserialize the data we have to remove the escaping. Every time we find 0x1B
-      // we know that this is an exaped character and is should be replaced by the character that follows.
-      //
-      const char ESCAPE_CHAR = 0x1B;
-      const char ESCAPE_ESCAPE_CHAR = 0x01;
-      const char NEWLINE_CHAR = 0x0A;
-      const char NEWLINE_ESCAPE_CHAR = 0x02;
-      const char CARRIAGERETURN_CHAR = 0x0D;
-      const char CARRIAGERETURN_ESCAPE_CHAR = 0x03;
-
-      std::vector<char> unescapedLineBuffer;
-
-      for (size_t i = 0; i < pbData->size(); i++) {
-         if (pbData->at(i) == NEWLINE_CHAR) {
-            std::vector<char> unescapedLine = unescapedLineBuffer;
-            unescapedLines.push_back(unescapedLine);
-            unescapedLineBuffer = std::vector<char>();
-         } else {
-            char b = pbData->at(i);
-            if (b == ESCAPE_CHAR) {
-               b = pbData->at(++i);
-               switch(b) {
-               case ESCAPE_ESCAPE_CHAR:
-                  unescapedLineBuffer.push_back(ESCAPE_CHAR);
-                  break;
-               case NEWLINE_ESCAPE_CHAR:
-                  unescapedLineBuffer.push_back(NEWLINE_CHAR);
-                  break;
-               case CARRIAGERETURN_ESCAPE_CHAR:
-                  unescapedLineBuffer.push_back(CARRIAGERETURN_CHAR);
-                  break;
-               default:
-                  unescapedLineBuffer.push_back(b);
-                  break;
-               }
-            } else {
-               unescapedLineBuffer.push_back(b);
+      size_t out = 0;
+      for (size_t i = 0; i < lineLength; i++) {
+         char b = line[i];
+         if (b == ESCAPE_CHAR && i + 1 < lineLength) {
+            b = line[++i];
+            switch(b) {
+            case ESCAPE_ESCAPE_CHAR:
+               b = ESCAPE_CHAR;
+               break;
+            case NEWLINE_ESCAPE_CHAR:
+               b = NEWLINE_CHAR;
+               break;
+            case CARRIAGERETURN_ESCAPE_CHAR:
+               b = CARRIAGERETURN_CHAR;
+               break;
+            default:
+               break;
             }
          }
+         line[out++] = b;
       }
+      return out;
    }
 
 
-   void processProtoBuffers(std::vector<char> *pbData,
-                            int &precision,
-                            std::string &pvName,
-                            std::string &units,
-                            double &displayHigh,
-                            double &displayLow,
-                            std::vector<ArchapplData::PBData> &pvData)
+   StreamDecoder::StreamDecoder() :
+      precision(0),
+      displayHigh(DBL_MIN),
+      displayLow(DBL_MAX),
+      headerComming(true),
+      type(ArchapplPB::SCALAR_STRING),
+      year(0),
+      eguAndPrecSet(false),
+      okay(true)
    {
-      ArchapplPB::PayloadInfo payloadInfo;
-      std::vector< std::vector<char> > unescapedLines;
+   }
+
+   StreamDecoder::~StreamDecoder()
+   {
+   }
+
+   bool StreamDecoder::processChunk(char *chunk, size_t size, std::vector<ArchapplData::PBData> &pvData)
+   {
+      // Newline characters are always escaped within a line, so we can find the
+      // line boundaries before unescaping.
+      //
+      size_t start = 0;
+      while (okay && start < size) {
+         char *newline = static_cast<char *>(memchr(chunk + start, NEWLINE_CHAR, size - start));
+         if (!newline) {
+            // Incomplete line - retain until the next chunk.
+            //
+            partialLine.insert(partialLine.end(), chunk + start, chunk + size);
+            break;
+         }
+
+         const size_t end = newline - chunk;
+         if (partialLine.empty()) {
+            processLine(chunk + start, end - start, pvData);
+         } else {
+            partialLine.insert(partialLine.end(), chunk + start, chunk + end);
+            processLine(&partialLine[0], partialLine.size(), pvData);
+            partialLine.clear();
+         }
+         start = end + 1;
+      }
+
+      return okay;
+   }
 
+   void StreamDecoder::processLine(char *line, size_t escapedLength, std::vector<ArchapplData::PBData> &pvData)
+   {
       // Archiver Appliance escapes special characters so that after serialization
       // each data point still falls in one line. To successfully parse the data
       // we first have to unsecape special characters.
       //
-      unescapePBData(pbData, unescapedLines);
-
-      bool headerComming = true;
-      ArchapplPB::PayloadType type = ArchapplPB::SCALAR_STRING;
-      int year = 0;
-      bool eguAndPrecSet = false;
-      displayHigh = DBL_MIN;
-      displayLow = DBL_MAX;
-
-      std::vector< std::vector<char> >::iterator it = unescapedLines.begin();
-      while (it != unescapedLines.end()) {
-         int lineLength = (*it).size();
-         const void* line = &((*(it++))[0]);
-         if (lineLength == 0) {
-            // We're at an empty line
-            //
-            headerComming = true;
-         } else if (headerComming && payloadInfo.ParseFromArray(line, lineLength)) {
-            // We're at a header line containing PV name, year, data type and possibly but not
-            // necessarily extra PV field values like EGU and PREC
-            //
-            pvName = payloadInfo.pvname();
-            type = payloadInfo.type();
-            year = payloadInfo.year();
+      const int lineLength = int(unescapeLine(line, escapedLength));
+      ArchapplPB::PayloadInfo payloadInfo;
 
-            // We only set engineering units and precission once as they are the same
-            // for the same PV
-            //
-            if (!eguAndPrecSet) {
-               for (int i = 0; i < payloadInfo.headers_size(); i++) {
-                  const ArchapplPB::FieldValue& value = payloadInfo.headers(i);
-                  std::string name = value.name();
-                  std::string fieldValue = value.val();
-                  if (name == "EGU") {
-                     units = fieldValue;
-                  } else if (name == "PREC") {
-                     //precision = std::stoi(fieldValue);
-                     precision = atoi( fieldValue.c_str() );
-                  }
+      if (lineLength == 0) {
+         // We're at an empty line
+         //
+         headerComming = true;
+      } else if (headerComming && payloadInfo.ParseFromArray(line, lineLength)) {
+         // We're at a header line containing PV name, year, data type and possibly but not
+         // necessarily extra PV field values like EGU and PREC
+         //
+         pvName = payloadInfo.pvname();
+         type = payloadInfo.type();
+         year = payloadInfo.year();
+
+         // We only set engineering units and precission once as they are the same
+         // for the same PV
+         //
+         if (!eguAndPrecSet) {
+            for (int i = 0; i < payloadInfo.headers_size(); i++) {
+               const ArchapplPB::FieldValue& value = payloadInfo.headers(i);
+               std::string name = value.name();
+               std::string fieldValue = value.val();
+               if (name == "EGU") {
+                  units = fieldValue;
+               } else if (name == "PREC") {
+                  //precision = std::stoi(fieldValue);
+                  precision = atoi( fieldValue.c_str() );
                }
-               eguAndPrecSet = true;
-            }
-            headerComming = false;
-         } else {
-            // We're at a line containing one PV data point along with timestamp,
-            // severity and status
-            //
-            ArchapplData::PBData onePointData;
-            switch (type) {
-            case ArchapplPB::SCALAR_SHORT:
-               processValue<ArchapplPB::ScalarShort>(line, lineLength, onePointData);
-               break;
-            case ArchapplPB::SCALAR_ENUM:
-               processValue<ArchapplPB::ScalarEnum>(line, lineLength, onePointData);
-               break;
-            case ArchapplPB::SCALAR_FLOAT:
-               processValue<ArchapplPB::ScalarFloat>(line, lineLength, onePointData);
-               break;
-            case ArchapplPB::SCALAR_DOUBLE:
-               processValue<ArchapplPB::ScalarDouble>(line, lineLength, onePointData);
-               break;
-            case ArchapplPB::SCALAR_INT:
-               processValue<ArchapplPB::ScalarInt>(line, lineLength, onePointData);
-               break;
-            default:
-               printf("archapplData.cpp:%d:%s Unsupported data format: %d\n", __LINE__, __FUNCTION__, int(type));
-               return;
             }
+            eguAndPrecSet = true;
+         }
+         headerComming = false;
+      } else {
+         // We're at a line containing one PV data point along with timestamp,
+         // severity and status
+         //
+         ArchapplData::PBData onePointData;
+         switch (type) {
+         case ArchapplPB::SCALAR_SHORT:
+            processValue<ArchapplPB::ScalarShort>(line, lineLength, onePointData);
+            break;
+         case ArchapplPB::SCALAR_ENUM:
+            processValue<ArchapplPB::ScalarEnum>(line, lineLength, onePointData);
+            break;
+         case ArchapplPB::SCALAR_FLOAT:
+            processValue<ArchapplPB::ScalarFloat>(line, lineLength, onePointData);
+            break;
+         case ArchapplPB::SCALAR_DOUBLE:
+            processValue<ArchapplPB::ScalarDouble>(line, lineLength, onePointData);
+            break;
+         case ArchapplPB::SCALAR_INT:
+            processValue<ArchapplPB::ScalarInt>(line, lineLength, onePointData);
+            break;
+         default:
+            printf("archapplData.cpp:%d:%s Unsupported data format: %d\n", __LINE__, __FUNCTION__, int(type));
+            okay = false;
+            return;
+         }
 
-            // HOPR and LOPR of a PV are simply added to one or more data point values
-            // We set them only once
-            //
-            if ((displayHigh ==  DBL_MIN || displayLow ==  DBL_MAX) && !onePointData.fieldValues.empty()) {
-               std::map<std::string,std::string>::iterator it;
-               for (it = onePointData.fieldValues.begin(); it != onePointData.fieldValues.end(); it++) {
-                  std::string name = it->first;
-                  std::string fieldValue = it->second;
-                  if (name == "HOPR") {
-                     displayHigh = atof(fieldValue.c_str());
-                  } else if (name == "LOPR") {
-                     displayLow = atof(fieldValue.c_str());
-                  }
+         // HOPR and LOPR of a PV are simply added to one or more data point values
+         // We set them only once
+         //
+         if ((displayHigh ==  DBL_MIN || displayLow ==  DBL_MAX) && !onePointData.fieldValues.empty()) {
+            std::map<std::string,std::string>::iterator it;
+            for (it = onePointData.fieldValues.begin(); it != onePointData.fieldValues.end(); it++) {
+               std::string name = it->first;
+               std::string fieldValue = it->second;
+               if (name == "HOPR") {
+                  displayHigh = atof(fieldValue.c_str());
+               } else if (name == "LOPR") {
+                  displayLow = atof(fieldValue.c_str());
                }
             }
+         }
 
-            onePointData.year = year;
-            pvData.push_back(onePointData);
+         onePointData.year = year;
+         pvData.push_back(onePointData);
 
-            headerComming = false;
-         }
+         headerComming = false;
       }
    }
+
+
+   void processProtoBuffers(std::vector<char> *pbData,
+                            int &precision,
+                            std::string &pvName,
+                            std::string &units,
+                            double &displayHigh,
+                            double &displayLow,
+                            std::vector<ArchapplData::PBData> &pvData)
+   {
+      // Process the whole response as one chunk. The decoder unescapes in
+      // place, so decode a copy and leave the caller's data unmodified.
+      //
+      StreamDecoder decoder;
+      if (!pbData->empty()) {
+         std::vector<char> buffer(*pbData);
+         decoder.processChunk(&buffer[0], buffer.size(), pvData);
+      }
+
+      precision = decoder.precision;
+      pvName = decoder.pvName;
+      units = decoder.units;
+      displayHigh = decoder.displayHigh;
+      displayLow = decoder.displayLow;
+   }
 }
 
 // end
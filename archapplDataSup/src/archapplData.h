@@ -73,6 +73,50 @@ namespace ArchapplData {
                             double &displayLow,
                             std::vector<PBData> &pvData);
 
+
+   /**
+    * Incremental Google Protcol Buffers processing
+    *
+    * The response data may be processed chunk by chunk as it is received, i.e.
+    * without first assembling the whole response. Each complete line is unescaped
+    * in place and decoded. Any incomplete line at the end of a chunk is retained
+    * and completed by the next chunk.
+    *
+    * The PV meta data (precision, pvName, units, displayHigh and displayLow) are
+    * available once the header line has been processed.
+    */
+   class epicsShareClass StreamDecoder {
+   public:
+      StreamDecoder();
+      ~StreamDecoder();
+
+      /**
+       * params:
+       *  - char *chunk                  [in]  next chunk of PB data for one PV - modified in place
+       *  - size_t size                  [in]  chunk size
+       *  - std::vector<PBData> &pvData  [out] decoded data points are appended to this vector
+       *
+       * returns false if an unsupported data format has been encountered
+       */
+      bool processChunk(char *chunk, size_t size, std::vector<PBData> &pvData);
+
+      int precision;
+      std::string pvName;
+      std::string units;
+      double displayHigh;
+      double displayLow;
+
+   private:
+      void processLine(char *line, size_t lineLength, std::vector<PBData> &pvData);
+
+      std::vector<char> partialLine;   // incomplete line from previous chunk(s)
+      bool headerComming;
+      int type;                        // ArchapplPB::PayloadType
+      int year;
+      bool eguAndPrecSet;
+      bool okay;
+   };
+
 }
 
 #endif // ARCHAPPLDATA_H
@@ -49,6 +49,11 @@
 
 #define DEBUG qDebug () << "QEArchiveInterfaceAA" << __LINE__ << __FUNCTION__  << "  "
 
+// Decoded values are delivered as a partial response once at least this
+// number of points is available.
+//
+#define PARTIAL_RESPONSE_SIZE  20000
+
 
 //------------------------------------------------------------------------------
 // Enable Archiver Appliance support
@@ -77,6 +82,26 @@ static bool setupMaps () {
 static const bool elaborateMaps = setupMaps ();
 
 
+//------------------------------------------------------------------------------
+// Per reply incremental values decoder. This is a child of the reply, and so
+// is deleted along with the reply.
+//
+class QEArchapplValuesDecoder : public QObject {
+public:
+   explicit QEArchapplValuesDecoder (QNetworkReply* reply) :
+      QObject (reply), year (-1), yearStartNSecs (0) { }
+   ~QEArchapplValuesDecoder () { }
+
+   ArchapplData::StreamDecoder decoder;
+   std::vector<ArchapplData::PBData> batch;   // decoded points - re-used for each chunk
+   QCaDataPointList dataPointList;
+
+   int year;                // year of the cached year start time
+   qint64 yearStartNSecs;   // start of year, nano seconds since the Qt epoch
+   QCaAlarmInfo alarm;      // alarm of the previous point
+};
+
+
 //==============================================================================
 // QEArchapplNetworkManager
 //==============================================================================
@@ -196,6 +221,24 @@ void QEArchapplNetworkManager::executeRequest(const QUrl url,
    // Do the plumbing
    //
    QObject::connect (reply, SIGNAL(finished()), this, SLOT(replyFinished()));
+
+   // Values are decoded as the data arrives, as opposed to waiting for the
+   // whole response and then decoding.
+   //
+   if (context.method == QEArchiveInterface::Values) {
+      QObject::connect (reply, SIGNAL(readyRead()), this, SLOT(replyReadyRead()));
+   }
+}
+
+void QEArchapplNetworkManager::replyReadyRead()
+{
+   QNetworkReply *reply = qobject_cast<QNetworkReply*>(sender());
+
+   if (reply && (reply->error() == QNetworkReply::NoError)) {
+      QVariant property = reply->property("context");
+      QEArchiveInterface::Context context = qvariant_cast<QEArchiveInterface::Context>(property);
+      emit this->networkManagerData(context, reply);
+   }
 }
 
 void QEArchapplNetworkManager::replyFinished()
@@ -240,6 +283,9 @@ QEArchapplInterface::QEArchapplInterface (QUrl url, QObject *parent) : QEArchive
    QObject::connect(this->networkManager, SIGNAL (networkManagerFault(const QEArchiveInterface::Context&, const QNetworkReply::NetworkError)),
                     this,                 SLOT   (networkManagerFault(const QEArchiveInterface::Context&, const QNetworkReply::NetworkError)));
 
+   QObject::connect(this->networkManager, SIGNAL (networkManagerData(const QEArchiveInterface::Context&, QNetworkReply*)),
+                    this,                 SLOT   (networkManagerData(const QEArchiveInterface::Context&, QNetworkReply*)));
+
    // Request info upon creation so that we can get the URL which is used to retrieve data
    //
    QObject userData;
@@ -398,6 +444,24 @@ void QEArchapplInterface::networkManagerFault(const QEArchiveInterface::Context
    };
 }
 
+//------------------------------------------------------------------------------
+//
+void QEArchapplInterface::networkManagerData(const QEArchiveInterface::Context & context,
+                                             QNetworkReply* reply)
+{
+   if (context.method != Values) return;
+
+   this->processValuesChunk (reply);
+
+   QEArchapplValuesDecoder* valuesDecoder = this->getValuesDecoder (reply, false);
+   if (valuesDecoder &&
+       valuesDecoder->dataPointList.count() >= PARTIAL_RESPONSE_SIZE) {
+      ResponseValueList PvValues;
+      PvValues.push_back(this->takeResponseValues (valuesDecoder));
+      emit this->valuesPartialResponse (context.userData, PvValues);
+   }
+}
+
 //------------------------------------------------------------------------------
 //
 void QEArchapplInterface::processInfo(const QObject* userData, QNetworkReply* reply)
@@ -502,75 +566,128 @@ void QEArchapplInterface::processArchives (const QObject* userData)
 }
 
 //------------------------------------------------------------------------------
+// Returns the reply's values decoder, creating it if needs be and requested.
 //
-void QEArchapplInterface::processValues(const QObject* userData, QNetworkReply* reply,
-                                        const unsigned int /* requested_element */)
+QEArchapplValuesDecoder* QEArchapplInterface::getValuesDecoder (QNetworkReply* reply,
+                                                                const bool create)
 {
-   QByteArray arrayData = reply->readAll();
+   QEArchapplValuesDecoder* result =
+         static_cast<QEArchapplValuesDecoder*> (reply->property ("valuesDecoder").value<void*> ());
 
-   if (arrayData.isNull()) {
-      DEBUG << "response empty";
-      return;
+   if (!result && create) {
+      result = new QEArchapplValuesDecoder (reply);
+      reply->setProperty ("valuesDecoder", QVariant::fromValue ((void*) result));
    }
+   return result;
+}
 
-   std::vector<char> charData;
-   charData.assign(arrayData.data(), arrayData.data() + arrayData.size());
+//------------------------------------------------------------------------------
+// Decode all the data currently available, and convert to data points.
+// Only complete lines are decoded, any partial line is retained by the decoder.
+//
+void QEArchapplInterface::processValuesChunk (QNetworkReply* reply)
+{
+   QByteArray chunk = reply->readAll();
+   if (chunk.isEmpty()) return;
 
-   std::vector<ArchapplData::PBData> pvData;
-   int precision;
-   std::string pvName;
-   std::string units;
-   double displayHigh;
-   double displayLow;
-   ArchapplData::processProtoBuffers(&charData, precision, pvName, units, displayHigh, displayLow, pvData);
+   QEArchapplValuesDecoder* valuesDecoder = this->getValuesDecoder (reply, true);
 
-   ResponseValueList PvValues;
-   QCaDataPointList dataPointList;
+   // Note: the chunk is unescaped in place.
+   //
+   valuesDecoder->decoder.processChunk (chunk.data(), size_t (chunk.size()),
+                                        valuesDecoder->batch);
 
-   std::vector<ArchapplData::PBData>::iterator it = pvData.begin();
-   while (it != pvData.end()) {
-      ArchapplData::PBData onePointData = *it;
+   std::vector<ArchapplData::PBData>::iterator it = valuesDecoder->batch.begin();
+   while (it != valuesDecoder->batch.end()) {
+      const ArchapplData::PBData& onePointData = *it;
 
       // To save space, the record processing timestamps in the samples are split into three parts
       // 1. year - This is stored once in the PB file in the header.
       // 2. secondsintoyear - This is stored with each sample.
       // 3. nano - This is stored with each sample.
       //
-      // Here we combine all three into one timestamp and covert to local time
+      // Here we combine all three into one timestamp, nano seconds since the epoch.
+      // The year start is only evaluated when the year changes, and there is no
+      // conversion to local time here - that happens if/when the point is extracted
+      // from the list as a QCaDataPoint. This also retains the full nano second resolution.
       //
-      QTime zeroTime (0, 0, 0);
-      QDateTime pointDateTime(QDate(onePointData.year, 1, 1), zeroTime);
-      pointDateTime.setTimeSpec(Qt::UTC);
-      pointDateTime = pointDateTime.addSecs(onePointData.seconds);
-      pointDateTime = pointDateTime.addMSecs((int)(onePointData.nanos/1000000));
-      pointDateTime = pointDateTime.toLocalTime();
-      QCaDateTime caDateTime(pointDateTime);
-
-      // Create a data point structure used by other clients
+      if (onePointData.year != valuesDecoder->year) {
+         const QDateTime yearStart (QDate (onePointData.year, 1, 1), QTime (0, 0, 0), Qt::UTC);
+         valuesDecoder->yearStartNSecs = yearStart.toMSecsSinceEpoch () * 1000000;
+         valuesDecoder->year = onePointData.year;
+      }
+
+      const qint64 nSecsSinceEpoch = valuesDecoder->yearStartNSecs +
+                                     qint64 (onePointData.seconds) * 1000000000 +
+                                     qint64 (onePointData.nanos);
+
+      // Alarm states change infrequently.
       //
-      QCaDataPoint dataPoint;
-      dataPoint.value = onePointData.value;
-      dataPoint.alarm = QCaAlarmInfo(onePointData.status, onePointData.severity);
-      dataPoint.datetime = caDateTime;
-      dataPointList.append(dataPoint);
+      if ((int (valuesDecoder->alarm.getStatus ()) != onePointData.status) ||
+          (int (valuesDecoder->alarm.getSeverity ()) != onePointData.severity)) {
+         valuesDecoder->alarm = QCaAlarmInfo (onePointData.status, onePointData.severity);
+      }
+
+      valuesDecoder->dataPointList.append (onePointData.value, nSecsSinceEpoch,
+                                           valuesDecoder->alarm);
 
       it++;
    }
 
-   ResponseValues responseValues;
-   responseValues.dataPoints = dataPointList;
-   responseValues.precision = precision;
-   responseValues.pvName = QString::fromStdString(pvName);
-   responseValues.units = QString::fromStdString(units);
-   responseValues.displayHigh = displayHigh;
-   responseValues.displayLow = displayLow;
-   responseValues.elementCount = dataPointList.count();
+   // The batch has been consumed - clear but retain the allocation.
+   //
+   valuesDecoder->batch.clear();
+}
+
+//------------------------------------------------------------------------------
+//
+void QEArchapplInterface::processValues(const QObject* userData, QNetworkReply* reply,
+                                        const unsigned int /* requested_element */)
+{
+   // Most if not all of the data has already been processed as it arrived.
+   // Process any remaining data.
+   //
+   this->processValuesChunk (reply);
 
-   PvValues.push_back(responseValues);   
+   QEArchapplValuesDecoder* valuesDecoder = this->getValuesDecoder (reply, false);
+   if (!valuesDecoder) {
+      DEBUG << "response empty";
+      return;
+   }
+
+   // Any points already delivered by partial responses are not included.
+   //
+   ResponseValueList PvValues;
+   PvValues.push_back(this->takeResponseValues (valuesDecoder));
 
    emit this->valuesResponse (userData, true, PvValues);
 }
 
+//------------------------------------------------------------------------------
+// Returns the decoded points not yet delivered, together with the PV meta data.
+//
+QEArchiveInterface::ResponseValues QEArchapplInterface::takeResponseValues (
+      QEArchapplValuesDecoder* valuesDecoder)
+{
+   const ArchapplData::StreamDecoder& decoder = valuesDecoder->decoder;
+
+   ResponseValues responseValues;
+   responseValues.dataPoints = valuesDecoder->dataPointList;
+   responseValues.precision = decoder.precision;
+   responseValues.pvName = QString::fromStdString(decoder.pvName);
+   responseValues.units = QString::fromStdString(decoder.units);
+   responseValues.displayHigh = decoder.displayHigh;
+   responseValues.displayLow = decoder.displayLow;
+   responseValues.elementCount = valuesDecoder->dataPointList.count();
+
+   // The points are now owned by the response. The decoder is deleted along
+   // with the reply, but no need to hang onto the data until then.
+   //
+   valuesDecoder->dataPointList.clear();
+
+   return responseValues;
+}
+
 #else
 
 //------------------------------------------------------------------------------
@@ -590,6 +707,8 @@ void QEArchapplNetworkManager::getValues(const QEArchiveInterface::Context&, con
 
 void QEArchapplNetworkManager::replyFinished() {}
 
+void QEArchapplNetworkManager::replyReadyRead() {}
+
 QEArchapplInterface::QEArchapplInterface (QUrl, QObject*) {}
 
 QEArchapplInterface::~QEArchapplInterface () {}
@@ -615,6 +734,9 @@ void QEArchapplInterface::networkManagerResponse (const QEArchiveInterface::Cont
 void QEArchapplInterface::networkManagerFault (const QEArchiveInterface::Context&,
                                                const QNetworkReply::NetworkError) {}
 
+void QEArchapplInterface::networkManagerData (const QEArchiveInterface::Context&,
+                                              QNetworkReply*) {}
+
 #endif
 
 // end
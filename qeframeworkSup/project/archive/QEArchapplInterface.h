@@ -44,6 +44,7 @@
 #include <QCaAlarmInfo.h>
 
 class QEArchapplNetworkManager;  // differed
+class QEArchapplValuesDecoder;   // differed
 
 /// Interface to EPICS Archiver Appliance.
 ///
@@ -83,10 +84,18 @@ public slots:
                                QNetworkReply* reply);
    void networkManagerFault(const QEArchiveInterface::Context& context,
                             const QNetworkReply::NetworkError error);
+   void networkManagerData(const QEArchiveInterface::Context& context,
+                           QNetworkReply* reply);
 
 private:
    QEArchapplNetworkManager* networkManager;
 
+   // Values replies are decoded incrementally as data is received.
+   //
+   QEArchapplValuesDecoder* getValuesDecoder (QNetworkReply* reply, const bool create);
+   void processValuesChunk (QNetworkReply* reply);
+   ResponseValues takeResponseValues (QEArchapplValuesDecoder* valuesDecoder);
+
    void processInfo     (const QObject* userData, QNetworkReply* reply);
    void processArchives (const QObject* userData);
    void processPvNames  (const QObject* userData, QNetworkReply* reply);
@@ -144,11 +153,20 @@ signals:
    void networkManagerFault (const QEArchiveInterface::Context& context,
                              const QNetworkReply::NetworkError error);
 
+   // Signals that (more) response data is available, i.e. prior to the response
+   // being finished. Only used for values requests.
+   //
+   void networkManagerData (const QEArchiveInterface::Context& context, QNetworkReply* reply);
+
 private slots:
    // Triggered from networ manager when the reply is finished and data us ready
    //
    void replyFinished();
 
+   // Triggered from networ manager when some data is ready
+   //
+   void replyReadyRead();
+
    // We are very popular
    //
    friend class QEArchapplInterface;
@@ -52,7 +52,9 @@ void QEArchiveAccess::initialiseArchiverType ()
 
 //------------------------------------------------------------------------------
 //
-QEArchiveAccess::QEArchiveAccess (QObject * parent) : QObject (parent)
+QEArchiveAccess::QEArchiveAccess (QObject * parent) :
+   QObject (parent),
+   incrementalResponses (false)
 {
    this->initialiseArchiverType ();  // idempotent
 
@@ -124,6 +126,20 @@ void QEArchiveAccess::setMessageSourceId (unsigned int messageSourceIdIn)
    this->setSourceId (messageSourceIdIn);
 }
 
+//------------------------------------------------------------------------------
+//
+void QEArchiveAccess::setIncrementalResponses (const bool enable)
+{
+   this->incrementalResponses = enable;
+}
+
+//------------------------------------------------------------------------------
+//
+bool QEArchiveAccess::getIncrementalResponses () const
+{
+   return this->incrementalResponses;
+}
+
 //------------------------------------------------------------------------------
 //
 void QEArchiveAccess::resendStatus ()
@@ -191,6 +207,40 @@ void QEArchiveAccess::actionArchiveResponse (const QEArchiveAccess::PVDataRespon
 {
    // Forward resonse on to the requestor.
    //
+   if (this->incrementalResponses) {
+      if (!response.isFinal) {
+         emit this->appendArchiveData (response.userData, response.pointsList,
+                                       response.pvName);
+      } else {
+         emit this->setArchiveData (response.userData, response.isSuccess,
+                                    response.pointsList, response.pvName,
+                                    response.supplementary);
+      }
+      return;
+   }
+
+   // Accumulate any batches on behalf of the requestor.
+   //
+   const PartialKey key (response.userData, response.pvName);
+
+   if (!response.isFinal) {
+      this->partialPoints [key].append (response.pointsList);
+      return;
+   }
+
+   if (this->partialPoints.contains (key)) {
+      QCaDataPointList pointsList = this->partialPoints.take (key);
+      if (response.isSuccess) {
+         pointsList.append (response.pointsList);
+      } else {
+         pointsList.clear ();
+      }
+      emit this->setArchiveData (response.userData, response.isSuccess,
+                                 pointsList, response.pvName,
+                                 response.supplementary);
+      return;
+   }
+
    emit this->setArchiveData (response.userData, response.isSuccess,
                               response.pointsList, response.pvName,
                               response.supplementary);
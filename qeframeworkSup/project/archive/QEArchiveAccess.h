@@ -27,7 +27,9 @@
 #ifndef QE_ARCHIVE_ACCESS_H
 #define QE_ARCHIVE_ACCESS_H
 
+#include <QHash>
 #include <QList>
+#include <QPair>
 #include <QMetaType>
 #include <QObject>
 #include <QString>
@@ -78,6 +80,15 @@ public:
    unsigned int getMessageSourceId () const;
    void setMessageSourceId (unsigned int messageSourceId);
 
+   // Some archivers deliver the data in batches as it is received. By default,
+   // batches are accumulated and the setArchiveData signal holds all the data
+   // points. When incremental responses are enabled, each batch is sent via the
+   // appendArchiveData signal as it becomes available, and the setArchiveData
+   // signal only holds the remaining points.
+   //
+   void setIncrementalResponses (const bool enable);
+   bool getIncrementalResponses () const;
+
    // Is archiver communication ready.
    //
    static bool isReady ();
@@ -177,6 +188,7 @@ public:
       QObject* userData;
       int metaRequest;        // defined by MetaRequests
       bool isSuccess;
+      bool isFinal;           // false for a partial response - more to follow
       QCaDataPointList pointsList;
       QString pvName;
       QString supplementary;  // error info when not successfull
@@ -198,6 +210,12 @@ signals:
                         const QString& pvName,
                         const QString& supplementary);
 
+   // Only sent when incremental responses are enabled - see above.
+   //
+   void appendArchiveData (const QObject* userData,
+                           const QCaDataPointList& pointsList,
+                           const QString& pvName);
+
 private:
    void initialiseArchiverType ();
 
@@ -210,6 +228,13 @@ private:
    QString constructorMessage;
    message_types constructorMessageType;
 
+   // Batches accumulated on behalf of the user when incremental responses
+   // are not enabled, keyed by user data and PV name.
+   //
+   typedef QPair<const QObject*, QString> PartialKey;
+   QHash<PartialKey, QCaDataPointList> partialPoints;
+   bool incrementalResponses;
+
    // Requests responses to/from the Archive Manager.
    //
 signals:
@@ -199,8 +199,14 @@ signals:
    // this indicates a successfull response, and when false indicates a fault
    // condition. For the later case, the actual value parameters are undefined.
    //
+   // Interfaces that decode values as the data arrives may emit zero or more
+   // valuesPartialResponse signals, each holding the next batch of data points,
+   // before the valuesResponse signal. The valuesResponse signal holds any
+   // remaining data points and is always the final response to a request.
+   //
    void pvNamesResponse  (const QObject*, const bool, const QEArchiveInterface::PVNameList&);
    void valuesResponse   (const QObject*, const bool, const QEArchiveInterface::ResponseValueList&);
+   void valuesPartialResponse (const QObject*, const QEArchiveInterface::ResponseValueList&);
    void infoResponse     (const QObject*, const bool, const int, const QString&);
    void archivesResponse (const QObject*, const bool, const QEArchiveInterface::ArchiveList&);
    void nextRequest      (const int requestIndex);
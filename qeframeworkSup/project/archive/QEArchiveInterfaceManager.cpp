@@ -131,6 +131,11 @@ QEArchiveInterfaceManager::QEArchiveInterfaceManager (const int instanceIn,
                      this, SLOT (valuesResponse (const QObject*, const bool,
                                                  const QEArchiveInterface::ResponseValueList&)));
 
+   QObject::connect (ai, SIGNAL (valuesPartialResponse (const QObject*,
+                                                        const QEArchiveInterface::ResponseValueList&)),
+                     this, SLOT (valuesPartialResponse (const QObject*,
+                                                        const QEArchiveInterface::ResponseValueList&)));
+
    #undef ai
 }
 
@@ -490,7 +495,10 @@ void QEArchiveInterfaceManager::valuesResponse (
 
    response.userData = requestInfo.request.userData;
    response.isSuccess = ((isSuccess) && (valuesList.size () == 1));
+   response.isFinal = true;
    if (response.isSuccess) {
+      // Only the points not sent in any partial response.
+      //
       response.pointsList = valuesList.front().dataPoints;
    }
    response.pvName = requestInfo.request.pvName;
@@ -502,6 +510,48 @@ void QEArchiveInterfaceManager::valuesResponse (
    emit this->aimDataResponse (requestInfo.archiveAccess, response);
 }
 
+//------------------------------------------------------------------------------
+// slot - from archiveInterface
+// The points are passed on as a partial response, they are not repeated in
+// the final response. The request remains active until the final response.
+//
+void QEArchiveInterfaceManager::valuesPartialResponse (
+      const QObject* userData,
+      const QEArchiveInterface::ResponseValueList& valuesList)
+{
+   const ValuesResponseContext* context =
+         dynamic_cast <const ValuesResponseContext*> (userData);
+
+   if (!context || (context->archiveInterfaceManager != this)) {
+      DEBUG  << "instance" << this->instance << "userData mis-match";
+      return;
+   }
+
+   RequestLists::iterator it = this->activeRequests.find (context->unique);
+   if (it == this->activeRequests.end ()) {
+      DEBUG  << "instance" << this->instance << "unique" << context->unique << "not active";
+      return;
+   }
+
+   if (valuesList.size () != 1) return;
+
+   const RequestInfo& requestInfo = it.value ();
+
+   QEArchiveAccess::PVDataResponses response;
+
+   response.userData = requestInfo.request.userData;
+   response.isSuccess = true;
+   response.isFinal = false;
+   response.pointsList = valuesList.front().dataPoints;
+   response.pvName = requestInfo.request.pvName;
+   response.metaRequest = requestInfo.request.metaRequest;
+   response.supplementary = "partial";
+
+   // Hand off the the Archiver Manager.
+   //
+   emit this->aimDataResponse (requestInfo.archiveAccess, response);
+}
+
 //------------------------------------------------------------------------------
 // slot
 void QEArchiveInterfaceManager::started ()
@@ -117,6 +117,9 @@ private slots:
    void valuesResponse   (const QObject* userData, const bool isSuccess,
                           const QEArchiveInterface::ResponseValueList& valuesList);
 
+   void valuesPartialResponse (const QObject* userData,
+                               const QEArchiveInterface::ResponseValueList& valuesList);
+
 private:
    enum Constants {
       maxActiveQueueSize = 200,   // maxiumum number of outstanding requests allowed.
@@ -657,6 +657,7 @@ void QEArchiveManager::readArchiveRequest (const QEArchiveAccess* archiveAccess,
    response.pvName = request.pvName;
    response.userData = request.userData;
    response.isSuccess = false;
+   response.isFinal = true;
    response.pointsList.clear ();
    response.supplementary = "fail";
 
@@ -782,6 +783,7 @@ void QEArchiveManager::clearPending ()
       response.pvName = pendingRequest.userRequest.pvName;
       response.userData = pendingRequest.userRequest.userData;
       response.isSuccess = false;
+      response.isFinal = true;
       response.pointsList.clear ();
       response.supplementary = "fail";
 
@@ -934,7 +936,11 @@ void QEArchiveManager::aimDataResponse (
       }
    }
 
-   this->resendStatus ();
+   // Partial responses do not change the number of pending requests.
+   //
+   if (response.isFinal) {
+      this->resendStatus ();
+   }
 }
 
 // end
@@ -0,0 +1,247 @@
+/*  QELockFreeQueue.h
+ *
+ *  This file is part of the EPICS QT Framework, initially developed at the
+ *  Australian Synchrotron.
+ *
+ *  Copyright (C) 2024 The EPICS QT Framework contributors.
+ *
+ *  The EPICS QT Framework is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  The EPICS QT Framework is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with the EPICS QT Framework.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef QE_LOCK_FREE_QUEUE_H
+#define QE_LOCK_FREE_QUEUE_H
+
+#include <QAtomicInteger>
+#include <QThread>
+
+/// QELockFreeQueue is a bounded, lock-free, multi-producer single-consumer queue.
+/// It is a ring buffer in which each cell carries a sequence number (after Vyukov)
+/// so that producers need only one compare and swap to claim a cell, and the
+/// consumer needs no atomic read-modify-write at all.
+///
+/// Enqueue may be called from any thread. Dequeue, dequeueBatch and clear must
+/// only be called from the one consumer thread (typically the main thread).
+/// Alternatively, dequeueConcurrent allows multiple consumers.
+///
+/// The capacity is rounded up to a power of 2. When the queue is full, enqueue
+/// behaves as per the overflow policy: either the item is rejected (enqueue returns
+/// false and the caller retains ownership of the item) or the producer yields until
+/// space becomes available.
+///
+/// As with QEThreadSafeQueue, if a queue of references, these may become
+/// un-referenced orphans when the queue cleared or deleted.
+//
+template <typename Type>
+class QELockFreeQueue {
+public:
+   enum OverflowPolicies {
+      opReject = 0,   // enqueue fails and returns false
+      opWait          // enqueue waits for the consumer to make space
+   };
+
+   explicit QELockFreeQueue (const int capacityIn,
+                             const OverflowPolicies policyIn = opReject) :
+      policy (policyIn)
+   {
+      quint32 size = 2;
+      while (int (size) < capacityIn && size < 0x40000000) size <<= 1;
+      this->capacity = size;
+      this->mask = size - 1;
+
+      this->cells = new Cell [size];
+      for (quint32 j = 0; j < size; j++) {
+         this->cells [j].sequence.storeRelease (j);
+      }
+
+      this->enqueuePosition.storeRelease (0);
+      this->dequeuePosition.storeRelease (0);
+      this->highWaterMark.storeRelease (0);
+      this->overflowCount.storeRelease (0);
+   }
+
+   ~QELockFreeQueue ()
+   {
+      delete [] this->cells;
+   }
+
+   // Thread safe enqueue using the queue's overflow policy.
+   // Returns true if the item has been enqueued.
+   //
+   inline bool enqueue (const Type& t)
+   {
+      return this->enqueue (t, this->policy);
+   }
+
+   // Thread safe enqueue using the specified overflow policy.
+   //
+   inline bool enqueue (const Type& t, const OverflowPolicies overflowPolicy)
+   {
+      while (!this->tryEnqueue (t)) {
+         if (overflowPolicy == opReject) {
+            this->overflowCount.fetchAndAddRelease (1);
+            return false;
+         }
+         QThread::yieldCurrentThread ();
+      }
+      return true;
+   }
+
+   // Consumer only. Returns true if an item has been dequeued, otherwise false.
+   // Same API as QEThreadSafeQueue.
+   //
+   inline bool dequeue (Type& t)
+   {
+      const quint32 pos = this->dequeuePosition.loadAcquire ();
+      Cell* cell = &this->cells [pos & this->mask];
+      const qint32 diff = qint32 (cell->sequence.loadAcquire () - (pos + 1));
+      if (diff < 0) return false;   // empty
+
+      t = cell->data;
+      cell->data = Type ();
+      cell->sequence.storeRelease (pos + this->capacity);
+      this->dequeuePosition.storeRelease (pos + 1);
+      return true;
+   }
+
+   // Multi-consumer dequeue. This may be called from any number of threads
+   // concurrently, but must not be mixed with dequeue/dequeueBatch/clear on
+   // the same queue instance. Useful when the queue is used as a free list,
+   // e.g. one releasing thread and many allocating threads.
+   //
+   inline bool dequeueConcurrent (Type& t)
+   {
+      Cell* cell;
+      quint32 pos = this->dequeuePosition.loadAcquire ();
+      while (true) {
+         cell = &this->cells [pos & this->mask];
+         const qint32 diff = qint32 (cell->sequence.loadAcquire () - (pos + 1));
+         if (diff == 0) {
+            if (this->dequeuePosition.testAndSetAcquire (pos, pos + 1)) break;
+            pos = this->dequeuePosition.loadAcquire ();   // lost the race
+         } else if (diff < 0) {
+            return false;   // empty
+         } else {
+            pos = this->dequeuePosition.loadAcquire ();   // lost the race
+         }
+      }
+
+      t = cell->data;
+      cell->data = Type ();
+      cell->sequence.storeRelease (pos + this->capacity);
+      return true;
+   }
+
+   // Consumer only. Dequeues up to maxNumber items into buffer.
+   // Returns the number of items dequeued.
+   //
+   inline int dequeueBatch (Type* buffer, const int maxNumber)
+   {
+      int count = 0;
+      while (count < maxNumber && this->dequeue (buffer [count])) count++;
+      return count;
+   }
+
+   // Consumer only. Not a deep clear - that is up to the user to mange.
+   //
+   inline void clear ()
+   {
+      Type t;
+      while (this->dequeue (t));
+   }
+
+   // Approximate number of items in the queue.
+   //
+   inline int size () const
+   {
+      const quint32 head = this->enqueuePosition.loadAcquire ();
+      const quint32 tail = this->dequeuePosition.loadAcquire ();
+      const qint32 diff = qint32 (head - tail);
+      return diff > 0 ? int (diff) : 0;
+   }
+
+   inline bool isEmpty () const { return this->size () == 0; }
+
+   inline int getCapacity () const { return int (this->capacity); }
+
+   // Maximum queue depth observed and number of rejected enqueue requests.
+   //
+   inline int getHighWaterMark () const { return this->highWaterMark.loadAcquire (); }
+   inline int getOverflowCount () const { return this->overflowCount.loadAcquire (); }
+
+   inline void resetStatistics ()
+   {
+      this->highWaterMark.storeRelease (this->size ());
+      this->overflowCount.storeRelease (0);
+   }
+
+private:
+   struct Cell {
+      QAtomicInteger<quint32> sequence;
+      Type data;
+   };
+
+   // Returns false if the queue is full.
+   //
+   inline bool tryEnqueue (const Type& t)
+   {
+      Cell* cell;
+      quint32 pos = this->enqueuePosition.loadAcquire ();
+      while (true) {
+         cell = &this->cells [pos & this->mask];
+         const qint32 diff = qint32 (cell->sequence.loadAcquire () - pos);
+         if (diff == 0) {
+            // Cell is free - attempt to claim it.
+            //
+            if (this->enqueuePosition.testAndSetAcquire (pos, pos + 1)) break;
+            pos = this->enqueuePosition.loadAcquire ();   // lost the race
+         } else if (diff < 0) {
+            return false;   // full
+         } else {
+            pos = this->enqueuePosition.loadAcquire ();   // lost the race
+         }
+      }
+
+      cell->data = t;
+      cell->sequence.storeRelease (pos + 1);
+
+      // Update statistics.
+      //
+      const int depth = int (qint32 (pos + 1 - this->dequeuePosition.loadAcquire ()));
+      int hwm = this->highWaterMark.loadAcquire ();
+      while (depth > hwm && !this->highWaterMark.testAndSetAcquire (hwm, depth)) {
+         hwm = this->highWaterMark.loadAcquire ();
+      }
+
+      return true;
+   }
+
+   Cell* cells;
+   quint32 capacity;
+   quint32 mask;
+   const OverflowPolicies policy;
+
+   // Keep producer and consumer positions on separate cache lines.
+   // Note: the Relaxed member names differ between Qt versions, so the
+   // Acquire/Release forms are used throughout for portability.
+   //
+   alignas (64) QAtomicInteger<quint32> enqueuePosition;
+   alignas (64) QAtomicInteger<quint32> dequeuePosition;
+   alignas (64) QAtomicInteger<int> highWaterMark;
+   QAtomicInteger<int> overflowCount;
+
+   Q_DISABLE_COPY (QELockFreeQueue)
+};
+
+#endif  // QE_LOCK_FREE_QUEUE_H
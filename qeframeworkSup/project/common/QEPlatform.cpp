@@ -36,6 +36,12 @@
 #endif
 
 #include <limits>
+#include <stdlib.h>
+
+#if defined(QE_SIMD_X86) && defined(_MSC_VER)
+#include <intrin.h>
+#include <immintrin.h>
+#endif
 
 // TODO check for QT 5.X and use inbuilt functions.
 
@@ -67,4 +73,53 @@ bool QEPlatform::isInf (const double x)
 
 }
 
+//------------------------------------------------------------------------------
+//
+static QEPlatform::SimdLevels determineSimdLevel ()
+{
+   QEPlatform::SimdLevels result = QEPlatform::simdNone;
+
+#if defined(QE_SIMD_X86) && defined(_MSC_VER)
+   int info [4];
+   __cpuid (info, 0);
+   const int maxLeaf = info [0];
+
+   __cpuid (info, 1);
+   if (info [3] & (1 << 26)) result = QEPlatform::simdSse2;
+
+   // AVX2 also requires the OS to save the ymm registers (OSXSAVE and XCR0).
+   //
+   const bool osxsave = (info [2] & (1 << 27)) != 0;
+   if ((maxLeaf >= 7) && osxsave && ((_xgetbv (0) & 0x06) == 0x06)) {
+      __cpuidex (info, 7, 0);
+      if (info [1] & (1 << 5)) result = QEPlatform::simdAvx2;
+   }
+
+#elif defined(QE_SIMD_X86)
+   __builtin_cpu_init ();
+   if (__builtin_cpu_supports ("sse2")) result = QEPlatform::simdSse2;
+   if (__builtin_cpu_supports ("avx2")) result = QEPlatform::simdAvx2;
+#endif
+
+   // Allow the level to be restricted, e.g. for comparison purposes.
+   //
+   const char* limitText = getenv ("QE_SIMD_LEVEL");
+   if (limitText) {
+      const int limit = atoi (limitText);
+      if ((limit >= QEPlatform::simdNone) && (limit < int (result))) {
+         result = QEPlatform::SimdLevels (limit);
+      }
+   }
+
+   return result;
+}
+
+//------------------------------------------------------------------------------
+//
+QEPlatform::SimdLevels QEPlatform::simdLevel ()
+{
+   static const SimdLevels level = determineSimdLevel ();   // thread safe initialisation
+   return level;
+}
+
 // end
@@ -47,6 +47,34 @@ public:
    /// This function test if the specified double floating point number is +/-Infinity.
    static bool isInf (const double x);
 
+   /// Vector instruction set extensions available on the host processor at run
+   /// time. Used to select between the SIMD and scalar versions of array kernels.
+   enum SimdLevels {
+      simdNone = 0,   ///< scalar only
+      simdSse2,       ///< SSE2 - 2 doubles per instruction
+      simdAvx2        ///< AVX2 - 4 doubles per instruction
+   };
+
+   /// Returns the highest available SIMD level. This is determined once only.
+   /// The environment variable QE_SIMD_LEVEL may be used to restrict the level,
+   /// e.g. QE_SIMD_LEVEL=0 forces the scalar kernels.
+   static SimdLevels simdLevel ();
+
+
+// Compiler support for x86 SIMD kernels. Kernel functions are individually
+// compiled for the target instruction set using QE_TARGET_SSE2/QE_TARGET_AVX2,
+// i.e. without requiring -mavx2 for the whole framework, and are then selected
+// at run time using simdLevel ().
+//
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define QE_SIMD_X86
+#define QE_TARGET_SSE2  __attribute__ ((target ("sse2")))
+#define QE_TARGET_AVX2  __attribute__ ((target ("avx2")))
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_AMD64))
+#define QE_SIMD_X86
+#define QE_TARGET_SSE2
+#define QE_TARGET_AVX2
+#endif
 
 #if QT_VERSION < 0x060000
 #define QEKeepEmptyParts QString::KeepEmptyParts
@@ -86,6 +86,8 @@ SOURCES += $$PWD/QEGraphicMarkup.cpp
 HEADERS += $$PWD/QEGraphicNames.h
 SOURCES += $$PWD/QEGraphicNames.cpp
 
+HEADERS += $$PWD/QELockFreeQueue.h
+
 HEADERS += $$PWD/QEOneToOne.h
 
 HEADERS += $$PWD/QEPVNameSelectDialog.h
@@ -26,15 +26,67 @@
 
 #include "QCaDataPoint.h"
 #include <math.h>
+#include <limits>
 #include <QDebug>
 #include <QEArchiveInterface.h>
 #include <QECommon.h>
 
 #define DEBUG  qDebug () << "QCaDataPoint" << __LINE__ <<  __FUNCTION__  << "  "
 
+// Number of points per storage chunk.
+//
+#define CHUNK_SIZE  1024
+
+// Minimum alarm table size at which entries no longer referenced by any point
+// are purged when points are removed. Thereafter twice the compacted size.
+//
+#define ALARM_COMPACT_SIZE  64
+
+// Summary pyramid - each level block holds 16 lower level blocks.
+//
+#define BLOCK_SHIFT  4
+
+// Packed time value used to represent an invalid/null date time.
+//
+static const qint64 nullNSecs = std::numeric_limits<qint64>::min ();
 
 static const QString stdFormat = "dd/MMM/yyyy HH:mm:ss";
 
+//------------------------------------------------------------------------------
+// Common to QCaDataPoint::isDisplayable and QCaDataPointList::isDisplayable.
+//
+static bool isDisplayableSeverity (const QCaAlarmInfo::Severity alarmSeverity)
+{
+   bool result;
+   QEArchiveInterface::archiveAlarmSeverity severity;
+
+   severity = (QEArchiveInterface::archiveAlarmSeverity) alarmSeverity;
+
+   switch (severity) {
+
+      case QEArchiveInterface::archSevNone:
+      case QEArchiveInterface::archSevMinor:
+      case QEArchiveInterface::archSevMajor:
+      case QEArchiveInterface::archSevEstRepeat:
+      case QEArchiveInterface::archSevRepeat:
+         result = true;
+         break;
+
+      case QEArchiveInterface::archSevInvalid:
+      case QEArchiveInterface::archSevDisconnect:
+      case QEArchiveInterface::archSevStopped:
+      case QEArchiveInterface::archSevDisabled:
+         result = false;
+         break;
+
+      default:
+         result = false;
+         break;
+   }
+
+   return result;
+}
+
 //==============================================================================
 // QCaDataPoint methods
 //==============================================================================
@@ -71,34 +123,7 @@ QCaDataPoint& QCaDataPoint::operator=(const QCaDataPoint& other)
 //
 bool QCaDataPoint::isDisplayable () const
 {
-   bool result;
-   QEArchiveInterface::archiveAlarmSeverity severity;
-
-   severity = (QEArchiveInterface::archiveAlarmSeverity) this->alarm.getSeverity ();
-
-   switch (severity) {
-
-      case QEArchiveInterface::archSevNone:
-      case QEArchiveInterface::archSevMinor:
-      case QEArchiveInterface::archSevMajor:
-      case QEArchiveInterface::archSevEstRepeat:
-      case QEArchiveInterface::archSevRepeat:
-         result = true;
-         break;
-
-      case QEArchiveInterface::archSevInvalid:
-      case QEArchiveInterface::archSevDisconnect:
-      case QEArchiveInterface::archSevStopped:
-      case QEArchiveInterface::archSevDisabled:
-         result = false;
-         break;
-
-      default:
-         result = false;
-         break;
-   }
-
-   return result;
+   return isDisplayableSeverity (this->alarm.getSeverity ());
 }
 
 //------------------------------------------------------------------------------
@@ -186,6 +211,14 @@ QString QCaDataPoint::toString (const QCaDateTime& originDateTime) const
 //
 QCaDataPointList::QCaDataPointList ()
 {
+   this->head = 0;
+   this->number = 0;
+   this->lastAlarmIndex = -1;
+   this->alarmCompactSize = ALARM_COMPACT_SIZE;
+   this->removed = 0;
+   for (int level = 0; level < NumberOfLevels; level++) {
+      this->levelFirstBlock [level] = 0;
+   }
 }
 
 //------------------------------------------------------------------------------
@@ -196,55 +229,148 @@ QCaDataPointList::~QCaDataPointList () {}  // place holder
 //
 void QCaDataPointList::reserve (const int size)
 {
-   this->data.reserve (size);
+   this->chunks.reserve ((this->head + size) / CHUNK_SIZE + 1);
 }
 
 //------------------------------------------------------------------------------
 //
 void QCaDataPointList::clear ()
 {
-   this->data.clear ();
+   this->chunks.clear ();
+   this->head = 0;
+   this->number = 0;
+   this->alarmTable.clear ();
+   this->alarmIndex.clear ();
+   this->lastAlarmIndex = -1;
+   this->alarmCompactSize = ALARM_COMPACT_SIZE;
+
+   this->removed = 0;
+   for (int level = 0; level < NumberOfLevels; level++) {
+      this->levels [level].clear ();
+      this->levelFirstBlock [level] = 0;
+   }
 }
 
 //------------------------------------------------------------------------------
 //
 void QCaDataPointList::removeLast ()
 {
-   int c = this->data.count ();
-   if (c > 0) this->data.remove (c - 1);
+   if (this->number <= 0) return;
+
+   this->chunks.last ().removeLast ();
+   this->number--;
+
+   if (this->number == 0) {
+      this->clear ();
+      return;
+   }
+
+   if (this->chunks.last ().isEmpty ()) {
+      this->chunks.removeLast ();
+   }
+   this->summaryTruncate ();
 }
 
 //------------------------------------------------------------------------------
 //
 void QCaDataPointList::removeFirst ()
 {
-   int c = this->data.count ();
-   if (c > 0) this->data.remove (0);
+   this->removeFirstItems (1);
 }
 
 //------------------------------------------------------------------------------
 // removes the first n available items from the list
+// Whole chunks are released as they are emptied, the rest is just book keeping.
 //
 void QCaDataPointList::removeFirstItems (const int n)
 {
-   int c = this->data.count ();
-   int r = MIN (c, n);
-   if (r > 0) this->data.remove (0, r);
+   const int r = MIN (this->number, n);
+   if (r <= 0) return;
+
+   if (r == this->number) {
+      this->clear ();
+      return;
+   }
+
+   this->head += r;
+   this->number -= r;
+   this->removed += r;
+
+   while (this->head >= CHUNK_SIZE) {
+      this->chunks.removeFirst ();
+      this->head -= CHUNK_SIZE;
+   }
+
+   this->summaryTrimFront ();
+   this->compactAlarmTable ();
 }
 
 //------------------------------------------------------------------------------
 //
 void QCaDataPointList::append (const QCaDataPoint& other)
 {
-   this->data.append (other);
+   const qint64 nSecs = other.datetime.isValid () ? other.datetime.getNSecsSinceEpoch () : nullNSecs;
+   this->append (other.value, nSecs, other.alarm);
+}
+
+//------------------------------------------------------------------------------
+//
+void QCaDataPointList::append (const double value, const qint64 nSecsSinceEpoch,
+                               const QCaAlarmInfo& alarm)
+{
+   this->appendPacked (this->pack (value, nSecsSinceEpoch, alarm));
+}
+
+//------------------------------------------------------------------------------
+//
+void QCaDataPointList::appendPacked (const PackedPoint& packed)
+{
+   if (this->chunks.isEmpty () || this->chunks.last ().count () >= CHUNK_SIZE) {
+      Chunk chunk;
+      chunk.reserve (CHUNK_SIZE);
+      this->chunks.append (chunk);
+   }
+
+   this->chunks.last ().append (packed);
+   this->summaryAppend (packed);
+   this->number++;
 }
 
 //------------------------------------------------------------------------------
+// The packed points are copied as is, only the alarm index is re-mapped, and
+// each of the other list's alarm table entries is looked up once only.
 //
 void  QCaDataPointList::append (const QCaDataPointList& other)
 {
-   for (int j = 0; j < other.count(); j++) {
-      this->data.append (other.data.value (j));
+   if (other.number <= 0) return;
+
+   if (&other == this) {
+      const QCaDataPointList copy = other;
+      this->append (copy);
+      return;
+   }
+
+   QVector<int> alarmMap (other.alarmTable.count (), -1);
+   this->reserve (this->number + other.number);
+
+   int j = 0;
+   while (j < other.number) {
+      const int k = other.head + j;
+      const Chunk& source = other.chunks.at (k / CHUNK_SIZE);
+      const int first = k % CHUNK_SIZE;
+      const int n = MIN (source.count () - first, other.number - j);
+      const PackedPoint* points = source.constData () + first;
+
+      for (int i = 0; i < n; i++) {
+         PackedPoint packed = points [i];
+         int& mapped = alarmMap [int (packed.alarmIndex)];
+         if (mapped < 0) {
+            mapped = this->alarmTableIndex (other.alarmTable.at (int (packed.alarmIndex)));
+         }
+         packed.alarmIndex = quint32 (mapped);
+         this->appendPacked (packed);
+      }
+      j += n;
    }
 }
 
@@ -252,54 +378,104 @@ void  QCaDataPointList::append (const QCaDataPointList& other)
 //
 void QCaDataPointList::replace (const int i, const QCaDataPoint& t)
 {
-   this->data.replace (i, t);
+   if ((i < 0) || (i >= this->number)) return;
+   const int k = this->head + i;
+   this->chunks [k / CHUNK_SIZE][k % CHUNK_SIZE] = this->pack (t);
+   this->summaryRecalculate (this->removed + i);
 }
 
 //------------------------------------------------------------------------------
 //
 int QCaDataPointList::count () const
 {
-   return this->data.count ();
+   return this->number;
 }
 
 //------------------------------------------------------------------------------
 //
 QCaDataPoint QCaDataPointList::value (const int j) const
 {
-   return this->data.value (j);
+   if ((j < 0) || (j >= this->number)) return QCaDataPoint ();
+   return this->unpack (this->at (j));
 }
 
 //------------------------------------------------------------------------------
 //
 QCaDataPoint QCaDataPointList::last () const
 {
-   return this->data.last ();
+   return this->value (this->number - 1);
+}
+
+//------------------------------------------------------------------------------
+//
+double QCaDataPointList::getValue (const int j) const
+{
+   return this->at (j).value;
+}
+
+//------------------------------------------------------------------------------
+//
+qint64 QCaDataPointList::getNSecsSinceEpoch (const int j) const
+{
+   return this->at (j).nSecsSinceEpoch;
+}
+
+//------------------------------------------------------------------------------
+//
+bool QCaDataPointList::isDisplayable (const int j) const
+{
+   return isDisplayableSeverity (this->at (j).severity);
 }
 
 //------------------------------------------------------------------------------
 //
 void QCaDataPointList::truncate (const int position)
 {
-   while (this->data.count () > position) {
-      this->removeLast ();
+   const int p = MAX (0, position);
+   if (p >= this->number) return;
+
+   if (p == 0) {
+      this->clear ();
+      return;
+   }
+
+   // Drop whole chunks beyond the new end, then truncate the last chunk.
+   //
+   const int k = this->head + p;                 // new end position
+   const int lastChunk = (k - 1) / CHUNK_SIZE;
+   while (this->chunks.count () > lastChunk + 1) {
+      this->chunks.removeLast ();
    }
+   this->chunks.last ().resize (k - lastChunk * CHUNK_SIZE);
+   this->number = p;
+   this->summaryTruncate ();
+   this->compactAlarmTable ();
 }
 
 //------------------------------------------------------------------------------
 //
 int QCaDataPointList::indexBeforeTime (const QCaDateTime& searchTime,
                                        const int defaultIndex) const
+{
+   const qint64 searchNSecs = searchTime.isValid () ? searchTime.getNSecsSinceEpoch () : nullNSecs;
+   return this->indexBeforeNSecs (searchNSecs, defaultIndex);
+}
+
+//------------------------------------------------------------------------------
+//
+int QCaDataPointList::indexBeforeNSecs (const qint64 searchNSecs,
+                                        const int defaultIndex) const
 {
    // Cover "corner-case" specific no answer cases.
    //
-   if (this->data.count () <= 0) return defaultIndex;
-   if (this->data.value (0).datetime > searchTime) return defaultIndex;
+   if (this->number <= 0) return defaultIndex;
+   if (this->at (0).nSecsSinceEpoch > searchNSecs) return defaultIndex;
 
    // Cover no need to search case.
    //
    int first = 0;
-   int last = this->data.count () - 1;
-   if (this->data.value (last).datetime <= searchTime) return last;
+   int last = this->number - 1;
+   if (this->at (last).nSecsSinceEpoch <= searchNSecs) return last;
 
    // We know first point <= searchTime, last point > searchTime
    // While first and last are not adjacent...
@@ -307,7 +483,7 @@ int QCaDataPointList::indexBeforeTime (const QCaDateTime& searchTime,
       // Perform binary search to find point of iterest.
       //
       int midway = (first + last) / 2;
-      if (this->data.value (midway).datetime <= searchTime) {
+      if (this->at (midway).nSecsSinceEpoch <= searchNSecs) {
          first = midway;
       } else {
          last = midway;
@@ -323,25 +499,33 @@ int QCaDataPointList::indexBeforeTime (const QCaDateTime& searchTime,
 //
 const QCaDataPoint* QCaDataPointList::findNearestPoint (const QCaDateTime& searchTime) const
 {
-   const int number = this->data.count ();
+   const int number = this->count ();
    const int first = 0;
    const int last = number - 1;
 
    // Cover "corner-case" cases.
    //
    if (number <= 0) return NULL;
-   if (searchTime <= this->data [first].datetime) return &this->data [first];
-   if (searchTime >= this->data [last].datetime)  return &this->data [last];
 
-   // number >= 2
-   const int before = this->indexBeforeTime (searchTime, 0);
-   const int after = before + 1;
-
-   double bsdt = this->data.value (before).datetime.secondsTo (searchTime);
-   double sadt = searchTime.secondsTo (this->data.value (after).datetime);
+   const qint64 searchNSecs = searchTime.isValid () ? searchTime.getNSecsSinceEpoch () : nullNSecs;
+   int index;
+   if (searchNSecs <= this->at (first).nSecsSinceEpoch) {
+      index = first;
+   } else if (searchNSecs >= this->at (last).nSecsSinceEpoch) {
+      index = last;
+   } else {
+      // number >= 2
+      const int before = this->indexBeforeTime (searchTime, 0);
+      const int after = before + 1;
+
+      const qint64 bsdt = searchNSecs - this->at (before).nSecsSinceEpoch;
+      const qint64 sadt = this->at (after).nSecsSinceEpoch - searchNSecs;
+
+      index = (bsdt < sadt) ? before : after;
+   }
 
-   const QCaDataPoint*  result = (bsdt < sadt) ? &this->data [before] : &this->data [after];
-   return result;
+   this->nearestPoint = this->value (index);
+   return &this->nearestPoint;
 }
 
 //------------------------------------------------------------------------------
@@ -350,27 +534,27 @@ void QCaDataPointList::resample (const QCaDataPointList& source,
                                  const double interval,
                                  const QCaDateTime& endTime)
 {
-   QCaDateTime firstTime;
    int j;
    int next;
-   QCaDateTime jthTime;
+   qint64 jthNSecs;
    QCaDataPoint point;
 
    this->clear ();
    if (source.count () <= 0) return;
 
-   firstTime = source.value (0).datetime;
-   jthTime = firstTime;
+   const qint64 firstNSecs = source.getNSecsSinceEpoch (0);
+   const qint64 endNSecs = endTime.getNSecsSinceEpoch ();
+   jthNSecs = firstNSecs;
    next = 0;
-   for (j = 0; jthTime < endTime; j++) {
+   for (j = 0; jthNSecs < endNSecs; j++) {
 
       // Calculate to nearest mSec.
       //
-      jthTime = firstTime.addMSecs ((qint64)( (double) j * 1000.0 * interval));
+      jthNSecs = firstNSecs + qint64 ((double) j * 1000.0 * interval) * 1000000;
 
-      while (next < source.count () && source.value (next).datetime <= jthTime) next++;
+      while (next < source.count () && source.getNSecsSinceEpoch (next) <= jthNSecs) next++;
       point = source.value (next - 1);
-      point.datetime = jthTime;
+      point.datetime = QCaDateTime::fromNSecsSinceEpoch (jthNSecs);
       this->append (point);
    }
 }
@@ -380,20 +564,20 @@ void QCaDataPointList::resample (const QCaDataPointList& source,
 void QCaDataPointList::compact (const QCaDataPointList& source)
 {
    int j;
-   QCaDataPoint lastPoint;
 
    this->clear ();
    if (source.count () <= 0) return;
 
    // Copy first point.
-   lastPoint = source.value (0);
-   this->append (lastPoint);
+   PackedPoint lastPoint = source.at (0);
+   this->append (source.value (0));
 
-   for (j = 1; j < source.data.count (); j++) {
-      QCaDataPoint point = source.data.value (j);
+   for (j = 1; j < source.count (); j++) {
+      const PackedPoint& point = source.at (j);
       if ((point.value != lastPoint.value) ||
-          (point.alarm != lastPoint.alarm)) {
-         this->append (point);
+          (point.severity != lastPoint.severity) ||
+          (point.status != lastPoint.status)) {
+         this->append (source.value (j));
          lastPoint = point;
       }
    }
@@ -453,7 +637,7 @@ bool QCaDataPointList::calculateStatistics (Statistics& statistics,
    statistics.initialValue = 0.0;
    statistics.finalValue = 0.0;
 
-   const int n = this->data.count ();
+   const int n = this->number;
    if (n < 1) return false;
 
    double sumWeight = 0.0;          // i.e. time between points.
@@ -464,7 +648,8 @@ bool QCaDataPointList::calculateStatistics (Statistics& statistics,
    // X here is time - relative to first time.
    // It's kind of arbitary - the slope works out the same.
    //
-   QCaDateTime startTime = this->data.value (0).datetime;
+   const qint64 startNSecs = this->at (0).nSecsSinceEpoch;
+   const qint64 nowNSecs = QCaDateTime (QDateTime::currentDateTime ()).getNSecsSinceEpoch ();
    double sumX = 0.0;
    double sumY = 0.0;
    double sumXX = 0.0;
@@ -473,11 +658,11 @@ bool QCaDataPointList::calculateStatistics (Statistics& statistics,
 
    bool isFirst = true;
    for (int j = 0; j < n; j++) {
-      const QCaDataPoint thisPoint = this->data.value (j+0);
+      const PackedPoint& thisPoint = this->at (j+0);
 
       // Skip undisplayable points, e.g.alarm invalid or disconnected.
       //
-      if (!thisPoint.isDisplayable()) continue;
+      if (!isDisplayableSeverity (thisPoint.severity)) continue;
       const double value = thisPoint.value;
 
       // Is there a following point?
@@ -485,15 +670,15 @@ bool QCaDataPointList::calculateStatistics (Statistics& statistics,
       if ((j + 1 < n) || extendToTimeNow) {
          // Yes - we can calculate the weight.
          //
-         double weight;
+         qint64 deltaNSecs;
          if (j + 1 < n) {
-            const QCaDataPoint nextPoint = this->data.value (j+1);
-            weight = thisPoint.datetime.secondsTo (nextPoint.datetime);
+            deltaNSecs = this->at (j+1).nSecsSinceEpoch - thisPoint.nSecsSinceEpoch;
          } else {
             // Must be extendToTimeNow set true.
             //
-            weight = thisPoint.datetime.secondsTo (QDateTime::currentDateTime().toUTC());
+            deltaNSecs = nowNSecs - thisPoint.nSecsSinceEpoch;
          }
+         const double weight = double (deltaNSecs) * 1.0e-9;
 
          sumWeight += weight;
          sumValue += weight * value;
@@ -515,7 +700,7 @@ bool QCaDataPointList::calculateStatistics (Statistics& statistics,
       // Least squares.
       // For x, use time from first point.
       //
-      const double x = startTime.secondsTo (thisPoint.datetime);
+      const double x = double (thisPoint.nSecsSinceEpoch - startNSecs) * 1.0e-9;
 
       sumX += x;
       sumY += value;
@@ -568,13 +753,14 @@ void QCaDataPointList::distribute (double distribution [], const int size,
       distribution [j] = 0.0;
    }
 
-   const int n = this->data.count ();
+   const qint64 nowNSecs = QCaDateTime (QDateTime::currentDateTime ()).getNSecsSinceEpoch ();
+   const int n = this->number;
    for (int j = 0; j < n; j++) {
-      const QCaDataPoint thisPoint = this->data.value (j+0);
+      const PackedPoint& thisPoint = this->at (j+0);
 
       // Skip undisplayable points, e.g.alarm invalid or disconnected.
       //
-      if (!thisPoint.isDisplayable()) continue;
+      if (!isDisplayableSeverity (thisPoint.severity)) continue;
       const double value = thisPoint.value;
 
       // Is there a following point?
@@ -582,15 +768,15 @@ void QCaDataPointList::distribute (double distribution [], const int size,
       if ((j + 1 < n) || extendToTimeNow) {
          // Yes - we can calculate the weight.
          //
-         double weight;
+         qint64 deltaNSecs;
          if (j + 1 < n) {
-            const QCaDataPoint nextPoint = this->data.value (j+1);
-            weight = thisPoint.datetime.secondsTo (nextPoint.datetime);
+            deltaNSecs = this->at (j+1).nSecsSinceEpoch - thisPoint.nSecsSinceEpoch;
          } else {
             // Must be extendToTimeNow set true.
             //
-            weight = thisPoint.datetime.secondsTo (QDateTime::currentDateTime().toUTC());
+            deltaNSecs = nowNSecs - thisPoint.nSecsSinceEpoch;
          }
+         const double weight = double (deltaNSecs) * 1.0e-9;
 
          // Avoid divide by zero, and the hence the creation of a NaN slot value
          //
@@ -611,6 +797,328 @@ void QCaDataPointList::distribute (double distribution [], const int size,
    }
 }
 
+//------------------------------------------------------------------------------
+//
+QCaDataPointList::PackedPoint QCaDataPointList::pack (const QCaDataPoint& point)
+{
+   const qint64 nSecs = point.datetime.isValid () ? point.datetime.getNSecsSinceEpoch () : nullNSecs;
+   return this->pack (point.value, nSecs, point.alarm);
+}
+
+//------------------------------------------------------------------------------
+//
+QCaDataPointList::PackedPoint QCaDataPointList::pack (const double value,
+                                                      const qint64 nSecsSinceEpoch,
+                                                      const QCaAlarmInfo& alarm)
+{
+   PackedPoint result;
+
+   result.value = value;
+   result.nSecsSinceEpoch = nSecsSinceEpoch;
+   result.severity = alarm.getSeverity ();
+   result.status = alarm.getStatus ();
+   result.alarmIndex = quint32 (this->alarmTableIndex (alarm));
+   return result;
+}
+
+//------------------------------------------------------------------------------
+// Returns the alarm table index of the alarm, adding it if needs be.
+//
+int QCaDataPointList::alarmTableIndex (const QCaAlarmInfo& alarm)
+{
+   // Alarm states change infrequently, so first check the previous alarm.
+   // Note: QCaAlarmInfo equality is status and severity only, so check the
+   // (PVA only) message as well.
+   //
+   int index = this->lastAlarmIndex;
+   if (index >= 0) {
+      const QCaAlarmInfo& item = this->alarmTable.at (index);
+      if (!((item == alarm) && (item.messageText () == alarm.messageText ()))) {
+         index = -1;
+      }
+   }
+
+   // Otherwise look up the whole table, so that each distinct alarm is held
+   // once only however often it recurs.
+   //
+   if (index < 0) {
+      const AlarmKey key ((quint32 (alarm.getStatus ()) << 16) | alarm.getSeverity (),
+                          alarm.messageText ());
+      index = this->alarmIndex.value (key, -1);
+      if (index < 0) {
+         index = this->alarmTable.count ();
+         this->alarmTable.append (alarm);
+         this->alarmIndex.insert (key, index);
+      }
+      this->lastAlarmIndex = index;
+   }
+
+   return index;
+}
+
+//------------------------------------------------------------------------------
+// Purges alarm table entries that are no longer referenced by any point, but
+// only once the table has grown, so that the cost is amortised over the many
+// removals and distinct alarms that it takes to get there.
+//
+void QCaDataPointList::compactAlarmTable ()
+{
+   const int tableSize = this->alarmTable.count ();
+   if (tableSize <= this->alarmCompactSize) return;
+
+   QVector<int> remap (tableSize, -1);
+   for (int j = 0; j < this->number; j++) {
+      remap [int (this->at (j).alarmIndex)] = 0;
+   }
+
+   QVector<QCaAlarmInfo> table;
+   this->alarmIndex.clear ();
+   for (int a = 0; a < tableSize; a++) {
+      if (remap [a] < 0) continue;   // not referenced
+      const QCaAlarmInfo& alarm = this->alarmTable.at (a);
+      const AlarmKey key ((quint32 (alarm.getStatus ()) << 16) | alarm.getSeverity (),
+                          alarm.messageText ());
+      remap [a] = table.count ();
+      table.append (alarm);
+      this->alarmIndex.insert (key, remap [a]);
+   }
+
+   for (int j = 0; j < this->number; j++) {
+      const int k = this->head + j;
+      PackedPoint& packed = this->chunks [k / CHUNK_SIZE][k % CHUNK_SIZE];
+      packed.alarmIndex = quint32 (remap [int (packed.alarmIndex)]);
+   }
+
+   this->lastAlarmIndex = -1;
+   this->alarmTable = table;
+   this->alarmCompactSize = MAX (ALARM_COMPACT_SIZE, 2 * table.count ());
+}
+
+//------------------------------------------------------------------------------
+//
+QCaDataPoint QCaDataPointList::unpack (const PackedPoint& packed) const
+{
+   QCaDataPoint result;
+
+   result.value = packed.value;
+   if (packed.nSecsSinceEpoch != nullNSecs) {
+      result.datetime = QCaDateTime::fromNSecsSinceEpoch (packed.nSecsSinceEpoch);
+   }
+   result.alarm = this->alarmTable.value (int (packed.alarmIndex));
+   return result;
+}
+
+//------------------------------------------------------------------------------
+//
+const QCaDataPointList::PackedPoint& QCaDataPointList::at (const int j) const
+{
+   const int k = this->head + j;
+   return this->chunks.at (k / CHUNK_SIZE).at (k % CHUNK_SIZE);
+}
+
+//------------------------------------------------------------------------------
+//
+QCaDataPointList::Summary QCaDataPointList::getSummary (const int first,
+                                                        const int last) const
+{
+   Block total;
+   blockClear (total);
+
+   const qint64 shift = this->removed;
+   qint64 pos = shift + MAX (0, first);
+   const qint64 end = shift + MIN (this->number - 1, last) + 1;   // exclusive
+
+   while (pos < end) {
+      // Find the highest level block that starts at pos and fits within the range.
+      //
+      int use = -1;
+      for (int level = 0; level < NumberOfLevels; level++) {
+         const qint64 size = qint64 (1) << (BLOCK_SHIFT * (level + 1));
+         if ((pos % size) != 0 || (pos + size) > end) break;
+         use = level;
+      }
+
+      if (use >= 0) {
+         const qint64 blockIndex = pos >> (BLOCK_SHIFT * (use + 1));
+         const int k = int (blockIndex - this->levelFirstBlock [use]);
+         blockMerge (total, this->levels [use].at (k));
+         pos += qint64 (1) << (BLOCK_SHIFT * (use + 1));
+      } else {
+         blockAddPoint (total, this->at (int (pos - shift)), pos);
+         pos++;
+      }
+   }
+
+   Summary result;
+   result.count = total.count;
+   result.undisplayable = total.undisplayable;
+   result.minimum = total.minimum;
+   result.maximum = total.maximum;
+   result.mean = (total.count > 0) ? total.sum / total.count : 0.0;
+   result.minIndex = (total.count > 0) ? int (total.minIndex - shift) : -1;
+   result.maxIndex = (total.count > 0) ? int (total.maxIndex - shift) : -1;
+   return result;
+}
+
+//------------------------------------------------------------------------------
+// static
+void QCaDataPointList::blockClear (Block& block)
+{
+   block.minimum = 0.0;
+   block.maximum = 0.0;
+   block.sum = 0.0;
+   block.minIndex = -1;
+   block.maxIndex = -1;
+   block.count = 0;
+   block.undisplayable = 0;
+}
+
+//------------------------------------------------------------------------------
+// static
+void QCaDataPointList::blockAddPoint (Block& block, const PackedPoint& point,
+                                      const qint64 absIndex)
+{
+   if (!isDisplayableSeverity (point.severity)) {
+      block.undisplayable++;
+      return;
+   }
+
+   const double value = point.value;
+   if ((block.count == 0) || (value < block.minimum)) {
+      block.minimum = value;
+      block.minIndex = absIndex;
+   }
+   if ((block.count == 0) || (value > block.maximum)) {
+      block.maximum = value;
+      block.maxIndex = absIndex;
+   }
+   block.sum += value;
+   block.count++;
+}
+
+//------------------------------------------------------------------------------
+// static
+void QCaDataPointList::blockMerge (Block& block, const Block& other)
+{
+   block.undisplayable += other.undisplayable;
+   if (other.count == 0) return;
+
+   if ((block.count == 0) || (other.minimum < block.minimum)) {
+      block.minimum = other.minimum;
+      block.minIndex = other.minIndex;
+   }
+   if ((block.count == 0) || (other.maximum > block.maximum)) {
+      block.maximum = other.maximum;
+      block.maxIndex = other.maxIndex;
+   }
+   block.sum += other.sum;
+   block.count += other.count;
+}
+
+//------------------------------------------------------------------------------
+// Adds the point about to be appended to the list to the summary pyramid.
+// Points are always appended in order, so the point's block is either the
+// last block or the next block at each level.
+//
+void QCaDataPointList::summaryAppend (const PackedPoint& point)
+{
+   const qint64 absIndex = this->removed + this->number;
+
+   for (int level = 0; level < NumberOfLevels; level++) {
+      const qint64 blockIndex = absIndex >> (BLOCK_SHIFT * (level + 1));
+      QList<Block>& blocks = this->levels [level];
+
+      if (blocks.isEmpty ()) {
+         this->levelFirstBlock [level] = blockIndex;
+      }
+
+      if (this->levelFirstBlock [level] + blocks.count () <= blockIndex) {
+         Block block;
+         blockClear (block);
+         blocks.append (block);
+      }
+
+      blockAddPoint (blocks.last (), point, absIndex);
+   }
+}
+
+//------------------------------------------------------------------------------
+// Discards blocks that only summarise removed points. The first remaining
+// block may include removed points - such a block is never used by getSummary
+// as it does not lie wholly within the list.
+//
+void QCaDataPointList::summaryTrimFront ()
+{
+   for (int level = 0; level < NumberOfLevels; level++) {
+      const qint64 size = qint64 (1) << (BLOCK_SHIFT * (level + 1));
+      QList<Block>& blocks = this->levels [level];
+
+      while (!blocks.isEmpty () &&
+             ((this->levelFirstBlock [level] + 1) * size <= this->removed)) {
+         blocks.removeFirst ();
+         this->levelFirstBlock [level]++;
+      }
+   }
+}
+
+//------------------------------------------------------------------------------
+// Discards blocks beyond the end of the list and recalculates the last block.
+//
+void QCaDataPointList::summaryTruncate ()
+{
+   const qint64 end = this->removed + this->number;   // exclusive
+
+   for (int level = 0; level < NumberOfLevels; level++) {
+      const qint64 size = qint64 (1) << (BLOCK_SHIFT * (level + 1));
+      QList<Block>& blocks = this->levels [level];
+
+      while (!blocks.isEmpty () &&
+             ((this->levelFirstBlock [level] + blocks.count () - 1) * size >= end)) {
+         blocks.removeLast ();
+      }
+   }
+
+   if (this->number > 0) {
+      this->summaryRecalculate (end - 1);
+   }
+}
+
+//------------------------------------------------------------------------------
+// Recalculates the block containing the specified point at each level.
+// Level 0 blocks are recalculated from the points, higher level blocks from
+// the lower level blocks.
+//
+void QCaDataPointList::summaryRecalculate (const qint64 absIndex)
+{
+   for (int level = 0; level < NumberOfLevels; level++) {
+      const int levelShift = BLOCK_SHIFT * (level + 1);
+      const qint64 blockIndex = absIndex >> levelShift;
+      const int k = int (blockIndex - this->levelFirstBlock [level]);
+      if ((k < 0) || (k >= this->levels [level].count ())) continue;
+
+      Block block;
+      blockClear (block);
+
+      if (level == 0) {
+         const qint64 from = MAX (blockIndex << levelShift, this->removed);
+         const qint64 to = MIN ((blockIndex + 1) << levelShift, this->removed + this->number);
+         for (qint64 a = from; a < to; a++) {
+            blockAddPoint (block, this->at (int (a - this->removed)), a);
+         }
+      } else {
+         const QList<Block>& lower = this->levels [level - 1];
+         const qint64 lowerFirst = this->levelFirstBlock [level - 1];
+         const qint64 from = MAX (blockIndex << BLOCK_SHIFT, lowerFirst);
+         const qint64 to = MIN ((blockIndex + 1) << BLOCK_SHIFT, lowerFirst + lower.count ());
+         for (qint64 c = from; c < to; c++) {
+            blockMerge (block, lower.at (int (c - lowerFirst)));
+         }
+      }
+
+      this->levels [level][k] = block;
+   }
+}
+
 //------------------------------------------------------------------------------
 // Register own meta types.
 // static
@@ -27,6 +27,9 @@
 #ifndef QE_DATA_POINT_H
 #define QE_DATA_POINT_H
 
+#include <QHash>
+#include <QList>
+#include <QPair>
 #include <QVector>
 #include <QMetaType>
 #include <QString>
@@ -44,7 +47,7 @@ class QE_FRAMEWORK_LIBRARY_SHARED_EXPORT QCaDataPoint {
 public:
    explicit QCaDataPoint ();
    QCaDataPoint (const QCaDataPoint& other);
-   virtual ~QCaDataPoint ();
+   ~QCaDataPoint ();
 
    QCaDataPoint& operator=(const QCaDataPoint& other);
 
@@ -78,6 +81,21 @@ public:
 /// It has now been modified to include a QList<QCaDataPoint> member. The
 /// downside of this is that we must now provide list member access functions.
 ///
+/// The points are now held in fixed size chunks, such that appending points and
+/// removing points from the front of the list, as done when trimming a history
+/// buffer, are both O(1) amortised, while random access is retained.
+///
+/// Within the list, points are held in a compact, trivially copyable form
+/// (value, nano seconds since epoch and packed alarm severity/status - 24 bytes)
+/// and are converted to/from QCaDataPoint at the API boundary. The full alarm
+/// information (e.g. PVA message) is held in a small per list alarm table.
+/// Use getValue, getNSecsSinceEpoch and isDisplayable within tight loops to
+/// avoid constructing QCaDataPoint objects.
+///
+/// The list also incrementally maintains a multi-resolution summary pyramid
+/// (min/max/sum per block of 16, 256, ... points) as points are appended, such
+/// that the summary of any index range may be found in O(log n) time.
+///
 class QE_FRAMEWORK_LIBRARY_SHARED_EXPORT QCaDataPointList {
 public:
    explicit QCaDataPointList ();
@@ -91,6 +109,12 @@ public:
    void removeFirst ();
    void append (const QCaDataPointList& other);
    void append (const QCaDataPoint& other);
+
+   // Appends a point without constructing an intermediate QCaDataPoint/QCaDateTime.
+   // The time is nano seconds since the Qt epoch (1970-01-01 00:00:00 UTC).
+   //
+   void append (const double value, const qint64 nSecsSinceEpoch,
+                const QCaAlarmInfo& alarm);
    void replace (const int i, const QCaDataPoint& t);
    int count () const;
 
@@ -101,6 +125,12 @@ public:
    QCaDataPoint value (const int j) const;
    QCaDataPoint last () const;
 
+   // Fast access to the j-th point's attributes - j must be a valid index.
+   //
+   double getValue (const int j) const;
+   qint64 getNSecsSinceEpoch (const int j) const;
+   bool isDisplayable (const int j) const;
+
    // Truncates the list at the given position index.
    // If the specified position index is beyond the end of the list, nothing happens.
    //
@@ -114,9 +144,34 @@ public:
    int indexBeforeTime (const QCaDateTime& searchTime,
                         const int defaultIndex) const;
 
+   // As above, but search time specified as nano seconds since the epoch.
+   //
+   int indexBeforeNSecs (const qint64 searchNSecs,
+                         const int defaultIndex) const;
+
+   // Summary of the displayable points within an index range.
+   // The mean is the point mean, i.e. not time weighted.
+   // minIndex and maxIndex are -1 when count is zero.
+   //
+   struct Summary {
+      int count;            // number of displayable points
+      int undisplayable;    // number of undisplayable points
+      double minimum;
+      double maximum;
+      double mean;
+      int minIndex;
+      int maxIndex;
+   };
+
+   // Returns the summary of the points in the index range [first, last].
+   // Uses the summary pyramid - cost is O(log n) as opposed to O(n).
+   //
+   Summary getSummary (const int first, const int last) const;
+
    // Return a reference to the point nearest to the specified time or NULL.
    // WARNING - do not store this reference. To be consider valid during the
-   // processing of a single event only.
+   // processing of a single event only. The referenced point is a copy held
+   // by the list and is overwritten by the next call.
    //
    const QCaDataPoint* findNearestPoint (const QCaDateTime& searchTime) const;
 
@@ -172,7 +227,70 @@ public:
                     const double first, const double increment) const;
 
 private:
-   QVector<QCaDataPoint> data;
+   struct PackedPoint {
+      double value;
+      qint64 nSecsSinceEpoch;
+      quint16 severity;
+      quint16 status;
+      quint32 alarmIndex;    // index into the alarm table
+   };
+
+   PackedPoint pack (const QCaDataPoint& point);
+   PackedPoint pack (const double value, const qint64 nSecsSinceEpoch,
+                     const QCaAlarmInfo& alarm);
+   QCaDataPoint unpack (const PackedPoint& packed) const;
+   const PackedPoint& at (const int j) const;
+   void appendPacked (const PackedPoint& packed);
+   int alarmTableIndex (const QCaAlarmInfo& alarm);
+   void compactAlarmTable ();
+
+   typedef QVector<PackedPoint> Chunk;
+
+   // All but the last chunk are full. The first head points of the first chunk
+   // have been removed.
+   //
+   QList<Chunk> chunks;
+   int head;
+   int number;    // number of points in the list
+
+   // Distinct alarm infos - typically very few. The index is keyed on the
+   // status/severity and (PVA only) message.
+   //
+   typedef QPair<quint32, QString> AlarmKey;
+   QVector<QCaAlarmInfo> alarmTable;
+   QHash<AlarmKey, int> alarmIndex;
+   int lastAlarmIndex;                   // most recently packed alarm
+   int alarmCompactSize;                 // see compactAlarmTable
+   mutable QCaDataPoint nearestPoint;    // used by findNearestPoint
+
+   // Summary pyramid. Level L block b summarises points with absolute indices
+   // [b*S, (b+1)*S) where S = 16**(L+1). The absolute index of a point is its
+   // index plus the total number of points ever removed from the front.
+   //
+   struct Block {
+      double minimum;
+      double maximum;
+      double sum;
+      qint64 minIndex;      // absolute
+      qint64 maxIndex;      // absolute
+      int count;
+      int undisplayable;
+   };
+
+   enum { NumberOfLevels = 5 };
+
+   static void blockClear (Block& block);
+   static void blockAddPoint (Block& block, const PackedPoint& point, const qint64 absIndex);
+   static void blockMerge (Block& block, const Block& other);
+
+   void summaryAppend (const PackedPoint& point);
+   void summaryTrimFront ();
+   void summaryTruncate ();
+   void summaryRecalculate (const qint64 absIndex);
+
+   qint64 removed;                        // number of points ever removed from the front
+   QList<Block> levels [NumberOfLevels];
+   qint64 levelFirstBlock [NumberOfLevels];
 };
 
 // These types are used in inter thread signals - must be registered.
@@ -0,0 +1,389 @@
+/* QCaDataPointStatistics.cpp
+ *
+ *  This file is part of the EPICS QT Framework, initially developed at the
+ *  Australian Synchrotron.
+ *
+ *  Copyright (C) 2024 The EPICS QT Framework contributors.
+ *
+ *  The EPICS QT Framework is free software: you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public License as published
+ *  by the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  The EPICS QT Framework is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with the EPICS QT Framework.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "QCaDataPointStatistics.h"
+#include <math.h>
+#include <QDebug>
+#include <QECommon.h>
+
+#define DEBUG  qDebug () << "QCaDataPointStatistics" << __LINE__ <<  __FUNCTION__  << "  "
+
+//------------------------------------------------------------------------------
+//
+QCaDataPointStatistics::QCaDataPointStatistics ()
+{
+   this->clear ();
+}
+
+//------------------------------------------------------------------------------
+//
+QCaDataPointStatistics::~QCaDataPointStatistics () {}  // place holder
+
+//------------------------------------------------------------------------------
+//
+void QCaDataPointStatistics::clear ()
+{
+   this->sumWeight = 0.0;
+   this->sumValue = 0.0;
+   this->sumValueSquared = 0.0;
+
+   this->originNSecs = 0;
+   this->sumX = 0.0;
+   this->sumY = 0.0;
+   this->sumXX = 0.0;
+   this->sumXY = 0.0;
+   this->count = 0;
+
+   this->finalValue = 0.0;
+
+   this->minQueue.clear ();
+   this->maxQueue.clear ();
+   this->appendedCount = 0;
+   this->removedCount = 0;
+   this->removalsSinceRecalculation = 0;
+
+   this->bins.clear ();
+   this->binFirst = 0.0;
+   this->binIncrement = 0.0;
+   this->binsAreValid = false;
+}
+
+//------------------------------------------------------------------------------
+//
+void QCaDataPointStatistics::pointAppended (const QCaDataPointList& list)
+{
+   const int n = list.count ();
+   if (n <= 0) return;
+
+   const int j = n - 1;
+   const qint64 nSecs = list.getNSecsSinceEpoch (j);
+
+   if (this->appendedCount == this->removedCount) {
+      // First point - use as the least squares time origin.
+      //
+      this->originNSecs = nSecs;
+   }
+
+   // The previous point now has a following point, so we can now include its
+   // time weighted contribution.
+   //
+   if ((j >= 1) && list.isDisplayable (j - 1)) {
+      const double weight = double (nSecs - list.getNSecsSinceEpoch (j - 1)) * 1.0e-9;
+      this->addInterval (list.getValue (j - 1), weight);
+   }
+
+   const qint64 index = this->appendedCount++;
+
+   // Skip undisplayable points, e.g.alarm invalid or disconnected.
+   //
+   if (!list.isDisplayable (j)) return;
+
+   const double value = list.getValue (j);
+   const double x = double (nSecs - this->originNSecs) * 1.0e-9;
+
+   this->sumX += x;
+   this->sumY += value;
+   this->sumXX += x * x;
+   this->sumXY += x * value;
+   this->count++;
+   this->finalValue = value;
+
+   Item item;
+   item.index = index;
+   item.value = value;
+
+   // Any earlier point with a value not less than this point's value can
+   // never again be the minimum - and vice versa for the maximum.
+   //
+   while (!this->minQueue.isEmpty () && (this->minQueue.last ().value >= value)) {
+      this->minQueue.removeLast ();
+   }
+   this->minQueue.append (item);
+
+   while (!this->maxQueue.isEmpty () && (this->maxQueue.last ().value <= value)) {
+      this->maxQueue.removeLast ();
+   }
+   this->maxQueue.append (item);
+}
+
+//------------------------------------------------------------------------------
+//
+void QCaDataPointStatistics::removingFirstPoint (const QCaDataPointList& list)
+{
+   const int n = list.count ();
+   if (n <= 0) return;
+
+   if (n == 1) {
+      // List about to become empty.
+      //
+      this->clear ();
+      return;
+   }
+
+   const qint64 index = this->removedCount++;
+
+   // Subtracting the contributions of removed points accumulates rounding
+   // errors, and the least squares time origin falls ever further behind the
+   // data. So once as many points have been removed as remain in the list,
+   // recalculate the sums from scratch - the cost is amortised O(1).
+   //
+   this->removalsSinceRecalculation++;
+   if (this->removalsSinceRecalculation >= n) {
+      this->recalculate (list, 1);
+
+   } else if (list.isDisplayable (0)) {
+      const qint64 nSecs = list.getNSecsSinceEpoch (0);
+      const double value = list.getValue (0);
+
+      // n >= 2, so the first point has a following point.
+      //
+      const double weight = double (list.getNSecsSinceEpoch (1) - nSecs) * 1.0e-9;
+      this->addInterval (value, -weight);
+
+      const double x = double (nSecs - this->originNSecs) * 1.0e-9;
+
+      this->sumX -= x;
+      this->sumY -= value;
+      this->sumXX -= x * x;
+      this->sumXY -= x * value;
+      this->count--;
+
+      if (this->count == 0) {
+         // Remove any accumulated rounding errors.
+         //
+         this->sumWeight = 0.0;
+         this->sumValue = 0.0;
+         this->sumValueSquared = 0.0;
+         this->sumX = 0.0;
+         this->sumY = 0.0;
+         this->sumXX = 0.0;
+         this->sumXY = 0.0;
+      }
+   }
+
+   if (!this->minQueue.isEmpty () && (this->minQueue.first ().index == index)) {
+      this->minQueue.removeFirst ();
+   }
+
+   if (!this->maxQueue.isEmpty () && (this->maxQueue.first ().index == index)) {
+      this->maxQueue.removeFirst ();
+   }
+}
+
+//------------------------------------------------------------------------------
+// Recalculates the sums from the list points from first onwards, using the
+// time of the first point as the least squares time origin. The distribution
+// is rebuilt when next required.
+//
+void QCaDataPointStatistics::recalculate (const QCaDataPointList& list, const int first)
+{
+   this->sumWeight = 0.0;
+   this->sumValue = 0.0;
+   this->sumValueSquared = 0.0;
+   this->sumX = 0.0;
+   this->sumY = 0.0;
+   this->sumXX = 0.0;
+   this->sumXY = 0.0;
+   this->count = 0;
+   this->binsAreValid = false;
+   this->removalsSinceRecalculation = 0;
+
+   const int n = list.count ();
+   if (first >= n) return;
+
+   this->originNSecs = list.getNSecsSinceEpoch (first);
+
+   for (int j = first; j < n; j++) {
+      const qint64 nSecs = list.getNSecsSinceEpoch (j);
+
+      if ((j > first) && list.isDisplayable (j - 1)) {
+         const double weight = double (nSecs - list.getNSecsSinceEpoch (j - 1)) * 1.0e-9;
+         this->addInterval (list.getValue (j - 1), weight);
+      }
+
+      if (!list.isDisplayable (j)) continue;
+
+      const double value = list.getValue (j);
+      const double x = double (nSecs - this->originNSecs) * 1.0e-9;
+
+      this->sumX += x;
+      this->sumY += value;
+      this->sumXX += x * x;
+      this->sumXY += x * value;
+      this->count++;
+   }
+}
+
+//------------------------------------------------------------------------------
+//
+bool QCaDataPointStatistics::getStatistics (const QCaDataPointList& list,
+                                            QCaDataPointList::Statistics& statistics,
+                                            const bool extendToTimeNow) const
+{
+   // Ensure not erroneous.
+   //
+   statistics.isDefined = false;
+   statistics.mean = 0.0;
+   statistics.stdDeviation = 0.0;
+   statistics.slope = 0.0;
+   statistics.integral = 0.0;
+   statistics.minimum = 0.0;
+   statistics.maximum = 0.0;
+   statistics.initialValue = 0.0;
+   statistics.finalValue = 0.0;
+
+   const int n = list.count ();
+   if ((n < 1) || (this->count < 1)) return false;
+
+   double weightTotal = this->sumWeight;
+   double valueTotal = this->sumValue;
+   double valueSquaredTotal = this->sumValueSquared;
+
+   // Extend last point to time now if required.
+   //
+   if (extendToTimeNow && list.isDisplayable (n - 1)) {
+      const qint64 nowNSecs = QCaDateTime (QDateTime::currentDateTime ()).getNSecsSinceEpoch ();
+      const double weight = double (nowNSecs - list.getNSecsSinceEpoch (n - 1)) * 1.0e-9;
+      const double value = list.getValue (n - 1);
+
+      weightTotal += weight;
+      valueTotal += weight * value;
+      valueSquaredTotal += weight * value * value;
+   }
+
+   if (weightTotal <= 0.0) return false;
+
+   statistics.mean = valueTotal / weightTotal;
+
+   // Variance:  mean (x^2) - mean (x)^2
+   // Ensure the variance is non-negative - see QCaDataPointList.
+   //
+   double variance = (valueSquaredTotal / weightTotal) - (statistics.mean * statistics.mean);
+   variance = MAX (variance, 0.0);
+   statistics.stdDeviation = sqrt (variance);
+
+   // Least Squares
+   //
+   if (this->count >= 2) {
+      double delta = (this->count * this->sumXX) - (this->sumX * this->sumX);
+      delta = MAX (delta, 1.0e-9);   // avoid the divide by zero
+      statistics.slope = ((this->count * this->sumXY) - (this->sumX * this->sumY)) / delta;
+   }
+
+   statistics.integral = valueTotal;
+
+   statistics.minimum = this->minQueue.isEmpty () ? 0.0 : this->minQueue.first ().value;
+   statistics.maximum = this->maxQueue.isEmpty () ? 0.0 : this->maxQueue.first ().value;
+
+   // The first point is almost always displayable.
+   //
+   for (int j = 0; j < n; j++) {
+      if (list.isDisplayable (j)) {
+         statistics.initialValue = list.getValue (j);
+         break;
+      }
+   }
+   statistics.finalValue = this->finalValue;
+
+   statistics.isDefined = true;
+   return true;
+}
+
+//------------------------------------------------------------------------------
+//
+void QCaDataPointStatistics::getDistribution (const QCaDataPointList& list,
+                                              double distribution [], const int size,
+                                              const bool extendToTimeNow,
+                                              const double first, const double increment)
+{
+   if (size <= 0) return;
+
+   // Rebuild if the distribution parameters have changed.
+   //
+   if (!this->binsAreValid || (this->bins.count () != size) ||
+       (this->binFirst != first) || (this->binIncrement != increment)) {
+      this->bins.resize (size);
+      list.distribute (this->bins.data (), size, false, first, increment);
+      this->binFirst = first;
+      this->binIncrement = increment;
+      this->binsAreValid = true;
+   }
+
+   for (int j = 0; j < size; j++) {
+      distribution [j] = this->bins.at (j);
+   }
+
+   // Extend last point to time now if required.
+   //
+   const int n = list.count ();
+   if (extendToTimeNow && (n >= 1) && list.isDisplayable (n - 1)) {
+      const int slot = this->slotOf (list.getValue (n - 1));
+      if (slot >= 0) {
+         const qint64 nowNSecs = QCaDateTime (QDateTime::currentDateTime ()).getNSecsSinceEpoch ();
+         distribution [slot] += double (nowNSecs - list.getNSecsSinceEpoch (n - 1)) * 1.0e-9;
+      }
+   }
+}
+
+//------------------------------------------------------------------------------
+// Returns the distribution slot for the value, or -1 if out of range.
+// Consistent with QCaDataPointList::distribute.
+//
+int QCaDataPointStatistics::slotOf (const double value) const
+{
+   const int size = this->bins.count ();
+
+   // Avoid divide by zero, and the hence the creation of a NaN slot value
+   //
+   const double realSlot = (value - this->binFirst) / MAX (this->binIncrement, 1.0e-20);
+
+   // Check for out of range values.
+   //
+   if (realSlot < 0.0 || realSlot >= size) return -1;
+
+   const int slot = int (realSlot);
+
+   // Belts 'n' braces
+   //
+   if (slot < 0 || slot >= size) return -1;
+
+   return slot;
+}
+
+//------------------------------------------------------------------------------
+// Adds (or removes when weight negative) the time weighted contribution of a point.
+//
+void QCaDataPointStatistics::addInterval (const double value, const double weight)
+{
+   this->sumWeight += weight;
+   this->sumValue += weight * value;
+   this->sumValueSquared += weight * value * value;
+
+   if (this->binsAreValid) {
+      const int slot = this->slotOf (value);
+      if (slot >= 0) {
+         this->bins [slot] += weight;
+      }
+   }
+}
+
+// end
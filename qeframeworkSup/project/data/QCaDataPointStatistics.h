@@ -0,0 +1,115 @@
+/* QCaDataPointStatistics.h
+ *
+ *  This file is part of the EPICS QT Framework, initially developed at the
+ *  Australian Synchrotron.
+ *
+ *  Copyright (C) 2024 The EPICS QT Framework contributors.
+ *
+ *  The EPICS QT Framework is free software: you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public License as published
+ *  by the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  The EPICS QT Framework is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with the EPICS QT Framework.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef QE_DATA_POINT_STATISTICS_H
+#define QE_DATA_POINT_STATISTICS_H
+
+#include <QList>
+#include <QVector>
+#include <QCaDataPoint.h>
+#include <QEFrameworkLibraryGlobal.h>
+
+/// Incrementally maintains the statistics and distribution of a QCaDataPointList
+/// that is used as a FIFO, i.e. points are appended to the end of the list and
+/// removed from the front of the list.
+///
+/// The owner calls pointAppended after appending each point to the list, and
+/// removingFirstPoint before removing the first point from the list. The
+/// statistics and distribution are then available in O(1) time, as opposed to
+/// QCaDataPointList::calculateStatistics and QCaDataPointList::distribute which
+/// are O(n). The results are the same, save for rounding.
+///
+/// Note: the distribution is rebuilt (O(n)) whenever its parameters change.
+/// The sums are also recalculated (O(n)) after every n removals in order to
+/// limit the accumulation of rounding errors, i.e. amortised O(1).
+//
+class QE_FRAMEWORK_LIBRARY_SHARED_EXPORT QCaDataPointStatistics {
+public:
+   explicit QCaDataPointStatistics ();
+   ~QCaDataPointStatistics ();
+
+   void clear ();
+
+   // Must be called after each point is appended to the list.
+   //
+   void pointAppended (const QCaDataPointList& list);
+
+   // Must be called before the first point is removed from the list.
+   //
+   void removingFirstPoint (const QCaDataPointList& list);
+
+   // Equivilent to list.calculateStatistics (statistics, extendToTimeNow).
+   //
+   bool getStatistics (const QCaDataPointList& list,
+                       QCaDataPointList::Statistics& statistics,
+                       const bool extendToTimeNow) const;
+
+   // Equivilent to list.distribute (distribution, size, extendToTimeNow, first, increment).
+   //
+   void getDistribution (const QCaDataPointList& list,
+                         double distribution [], const int size,
+                         const bool extendToTimeNow,
+                         const double first, const double increment);
+
+private:
+   // Time weighted sums, i.e. those points with a following point.
+   //
+   double sumWeight;
+   double sumValue;
+   double sumValueSquared;
+
+   // Least squares sums. X is time relative to originNSecs.
+   //
+   qint64 originNSecs;
+   double sumX;
+   double sumY;
+   double sumXX;
+   double sumXY;
+   int count;               // number of displayable points
+
+   double finalValue;       // last displayable value
+
+   // Sliding window min/max - monotonic queues of displayable points.
+   //
+   struct Item {
+      qint64 index;         // absolute index
+      double value;
+   };
+   QList<Item> minQueue;
+   QList<Item> maxQueue;
+   qint64 appendedCount;    // absolute index of next point
+   qint64 removedCount;     // absolute index of first point
+   int removalsSinceRecalculation;
+
+   // Distribution (without extension to time now).
+   //
+   QVector<double> bins;
+   double binFirst;
+   double binIncrement;
+   bool binsAreValid;
+
+   void recalculate (const QCaDataPointList& list, const int first);
+   int slotOf (const double value) const;
+   void addInterval (const double value, const double weight);
+};
+
+#endif  // QE_DATA_POINT_STATISTICS_H
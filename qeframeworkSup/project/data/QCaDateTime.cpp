@@ -193,4 +193,33 @@ int QCaDateTime::getUserTag() const
    return this->userTag;
 }
 
+/*
+  Returns number of nano-seconds since the Qt epoch.
+ */
+qint64 QCaDateTime::getNSecsSinceEpoch() const
+{
+   return this->toMSecsSinceEpoch() * 1000000 + qint64 (this->nSec);
+}
+
+/*
+  Construct a QCa date time from a number of nano-seconds since the Qt epoch.
+ */
+QCaDateTime QCaDateTime::fromNSecsSinceEpoch( const qint64 nSecsSinceEpoch )
+{
+   QCaDateTime result;
+
+   // Floor division - ensure remainder is non-negative.
+   //
+   qint64 mSec = nSecsSinceEpoch / 1000000;
+   qint64 remainder = nSecsSinceEpoch % 1000000;
+   if( remainder < 0 ) {
+      remainder += 1000000;
+      mSec -= 1;
+   }
+
+   result.setMSecsSinceEpoch (mSec);
+   result.nSec = (unsigned long) remainder;
+   return result;
+}
+
 // end
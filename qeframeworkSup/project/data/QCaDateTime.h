@@ -65,6 +65,13 @@ public:
     unsigned long getNanoSeconds() const;
     int getUserTag() const;
 
+    /// Nano seconds since the Qt/Unix epoch (1970-01-01T00:00:00 UTC), and the
+    /// inverse. Provides a compact representation suitable for bulk storage.
+    /// Note: the user tag is not retained.
+    //
+    qint64 getNSecsSinceEpoch() const;
+    static QCaDateTime fromNSecsSinceEpoch( const qint64 nSecsSinceEpoch );
+
 private:
     unsigned long nSec;
     int userTag;
@@ -30,14 +30,18 @@
 #include <QApplication>
 #include <QDebug>
 #include <QByteArray>
+#include <QTimer>
 #include <QECommon.h>
+#include <QEAdaptationParameters.h>
 #include <QEPvNameUri.h>
 #include <QENullClient.h>
 #include <QECaClient.h>
 #include <QEPvaClient.h>
+#include <QEChannelRegistry.h>
 #include <QEStringFormatting.h>
 #include <QEIntegerFormatting.h>
 #include <QEFloatingFormatting.h>
+#include <QEVectorVariants.h>
 
 #define DEBUG qDebug () << "QCaObject" << __LINE__ << __FUNCTION__ << "  "
 
@@ -55,6 +59,18 @@ int QCaObject::connectedCount = 0;
 //
 QCaObject::ObjectIdentity QCaObject::nextObjectIdentity = 0;
 
+// Application default maximum update rate - read on first use.
+//
+double QCaObject::defaultMaximumUpdateRate = 0.0;
+bool QCaObject::defaultMaximumUpdateRateIsSet = false;
+
+// Objects awaiting a put callback from a shared client, in put order.
+// Only the object at the head of each list is connected to the client's
+// putCallbackComplete signal, so that each completion reaches only the
+// object that initiated the put.
+//
+static QHash<QEBaseClient*, QList<QCaObject*> > putCallbackInitiators;
+
 //------------------------------------------------------------------------------
 // static
 int* QCaObject::getDisconnectedCountRef()
@@ -69,6 +85,25 @@ int* QCaObject::getConnectedCountRef()
    return &QCaObject::connectedCount;
 }
 
+//------------------------------------------------------------------------------
+// static
+void QCaObject::setDefaultMaximumUpdateRate (const double rate)
+{
+   QCaObject::defaultMaximumUpdateRate = MAX (rate, 0.0);
+   QCaObject::defaultMaximumUpdateRateIsSet = true;
+}
+
+//------------------------------------------------------------------------------
+// static
+double QCaObject::getDefaultMaximumUpdateRate ()
+{
+   if (!QCaObject::defaultMaximumUpdateRateIsSet) {
+      QEAdaptationParameters ap ("QE_");
+      QCaObject::setDefaultMaximumUpdateRate (ap.getFloat ("max_update_rate", 0.0));
+   }
+   return QCaObject::defaultMaximumUpdateRate;
+}
+
 //------------------------------------------------------------------------------
 // The event object can be any Qt object with an event queue.
 // A filter will be inserted (and removed) by this class to catch
@@ -125,6 +160,26 @@ void QCaObject::initialise( const QString& newRecordName,
    this->userMessage = userMessageIn;
    this->signalsToSend = signalsToSendIn;
 
+   this->clientIsShared = false;
+   this->sharedChannelIsOpen = false;
+   this->replayIsPending = false;
+   this->priority = priorityIn;
+   this->requestedElementCount = 0;
+   this->usePutCallback = false;
+
+   this->maximumUpdateRate = QCaObject::getDefaultMaximumUpdateRate ();
+   this->minimumUpdateInterval = 0;
+   this->minimumInterval = 0;
+   this->absoluteDeadband = 0.0;
+   this->relativeDeadband = 0.0;
+   this->autoDeadband = false;
+   this->lastEmitValue = 0.0;
+   this->lastEmitValueIsValid = false;
+   this->coalesceTimer = NULL;
+   this->updatePending = false;
+   this->firstUpdate = false;
+   this->calcMinimumInterval ();    // apply the application default rate
+
    // Attempt to decode the given name into a protocol and an actual PV name.
    // If not specified, the 'ca://' Channel Access protocol is the default.
    //
@@ -132,37 +187,80 @@ void QCaObject::initialise( const QString& newRecordName,
    const bool decodeOkay = uri.decodeUri (newRecordName, /* strict=> */ false);
    if (!decodeOkay) {
       DEBUG << "PV protocol identification failed for:" << newRecordName;
-      // See comment below
+      // See comment in createPrivateClient
       this->client = new QENullClient (newRecordName, this);
       return;
    }
 
-   const QEPvNameUri::Protocol protocol = uri.getProtocol ();
-   const QString pvName = uri.getPvName ();
+   this->pvNameUri = uri;
+   this->uriPvRequest = uri.getPvRequest ();
+
+   // Identical PVs share the one client when sharing is enabled.
+   // Note: singleShotRead and connectChannel revert to a private client.
+   //
+   if (QEChannelRegistry::isEnabled ()) {
+      this->attachSharedClient ();
+   } else {
+      this->createPrivateClient ();
+   }
+
+   // Setup any the mechanism to handle messages to the user, if supplied
+   this->setUserMessage( userMessageIn );
+
+   // Update counters. Ensure consistant
+   //
+   QCaObject::totalChannelCount++;
+   QCaObject::connectedCount = LIMIT (QCaObject::connectedCount, 0, QCaObject::totalChannelCount);
+   QCaObject::disconnectedCount = QCaObject::totalChannelCount - QCaObject::connectedCount;
+}
+
+//------------------------------------------------------------------------------
+// Destructor.
+//
+QCaObject::~QCaObject()
+{
+   // NOTE: we call closeChannel before the client destructor so that the overriden
+   // connectionUpdate still gets invoked.
+   // Note: closeChannel and openChannel are now dispatching
+   //
+   if (this->client) {
+      if (this->clientIsShared) {
+         this->releaseClient ();
+      } else {
+         this->client->closeChannel ();
+      }
+   }
+
+   QCaObject::totalChannelCount--;
+   QCaObject::connectedCount = LIMIT (QCaObject::connectedCount, 0, QCaObject::totalChannelCount);
+   QCaObject::disconnectedCount = QCaObject::totalChannelCount - QCaObject::connectedCount;
+}
+
+//------------------------------------------------------------------------------
+// Creates a client owned by this object.
+//
+void QCaObject::createPrivateClient ()
+{
+   const QEPvNameUri::Protocol protocol = this->pvNameUri.getProtocol ();
+   const QString pvName = this->pvNameUri.getPvName ();
 
    QECaClient* caClient;
+   QEPvaClient* pvaClient;
 
    switch (protocol) {
 
       case QEPvNameUri::ca:
          this->client = caClient = new QECaClient (pvName, this);
-         caClient->setPriority (int (priorityIn));
-         QObject::connect (this->client, SIGNAL (connectionUpdated (const bool)),
-                           this,         SLOT   (connectionUpdate  (const bool)));
-         QObject::connect (this->client, SIGNAL (dataUpdated (const bool)),
-                           this,         SLOT   (dataUpdate  (const bool)));
-         QObject::connect (this->client, SIGNAL (putCallbackComplete    (const bool)),
-                           this,         SLOT   (putCallbackNotifcation (const bool)));
+         caClient->setPriority (int (this->priority));
+         if (this->requestedElementCount > 0) {
+            caClient->setRequestCount (this->requestedElementCount);
+         }
+         caClient->setUsePutCallback (this->usePutCallback);
          break;
 
       case QEPvNameUri::pva:
-         this->client = new QEPvaClient (pvName, this);
-         QObject::connect (this->client, SIGNAL (connectionUpdated (const bool)),
-                           this,         SLOT   (connectionUpdate  (const bool)));
-         QObject::connect (this->client, SIGNAL (dataUpdated (const bool)),
-                           this,         SLOT   (dataUpdate  (const bool)));
-         QObject::connect (this->client, SIGNAL (putCallbackComplete    (const bool)),
-                           this,         SLOT   (putCallbackNotifcation (const bool)));
+         this->client = pvaClient = new QEPvaClient (pvName, this);
+         pvaClient->setPvRequest (this->pvNameUri.getPvRequest ());
          break;
 
       default:
@@ -178,30 +276,149 @@ void QCaObject::initialise( const QString& newRecordName,
          this->client = new QENullClient (pvName, this);
    }
 
-   // Setup any the mechanism to handle messages to the user, if supplied
-   this->setUserMessage( userMessageIn );
+   this->clientIsShared = false;
+   this->connectClient ();
+   this->client->setUserMessage (this->userMessage);
+}
 
-   // Update counters. Ensure consistant
-   //
-   QCaObject::totalChannelCount++;
-   QCaObject::connectedCount = LIMIT (QCaObject::connectedCount, 0, QCaObject::totalChannelCount);
-   QCaObject::disconnectedCount = QCaObject::totalChannelCount - QCaObject::connectedCount;
+//------------------------------------------------------------------------------
+// Attaches to a client owned by the channel registry.
+//
+void QCaObject::attachSharedClient ()
+{
+   this->client = QEChannelRegistry::attach (this->pvNameUri,
+                                             this->requestedElementCount,
+                                             unsigned (this->priority));
+   if (!this->client) {
+      // Unsupported protocol - fall back to a private null client.
+      //
+      this->createPrivateClient ();
+      return;
+   }
+
+   this->clientIsShared = true;
+   this->sharedChannelIsOpen = false;
+   this->connectClient ();
 }
 
 //------------------------------------------------------------------------------
-// Destructor.
+// Releases the current client, whether private or shared.
 //
-QCaObject::~QCaObject()
+void QCaObject::releaseClient ()
 {
-   // NOTE: we call closeChannel before the client destructor so that the overriden
-   // connectionUpdate still gets invoked.
-   // Note: closeChannel and openChannel are now dispatching
+   if (!this->client) return;
+
+   QObject::disconnect (this->client, 0, this, 0);
+
+   if (this->clientIsShared) {
+      this->removePutCallbackInitiator ();
+      if (this->sharedChannelIsOpen) {
+         // As per closeChannel, report the disconnection on the client's behalf.
+         //
+         const bool wasConnected = this->client->getIsConnected ();
+         QEChannelRegistry::closeChannel (this->client);
+         this->sharedChannelIsOpen = false;
+         if (wasConnected) {
+            this->connectionUpdate (false);
+         }
+      }
+      QEChannelRegistry::detach (this->client);
+   } else {
+      this->client->closeChannel ();
+      this->client->deleteLater ();
+   }
+
+   this->client = NULL;
+   this->clientIsShared = false;
+}
+
+//------------------------------------------------------------------------------
+//
+void QCaObject::connectClient ()
+{
+   QObject::connect (this->client, SIGNAL (connectionUpdated (const bool)),
+                     this,         SLOT   (connectionUpdate  (const bool)));
+   QObject::connect (this->client, SIGNAL (dataUpdated (const bool)),
+                     this,         SLOT   (dataUpdate  (const bool)));
+
+   // Shared clients - only connected while at the head of the initiator list.
    //
-   if (this->client) this->client->closeChannel ();
+   if (!this->clientIsShared || this->isPutCallbackHead ()) {
+      this->connectPutCallback ();
+   }
+}
 
-   QCaObject::totalChannelCount--;
-   QCaObject::connectedCount = LIMIT (QCaObject::connectedCount, 0, QCaObject::totalChannelCount);
-   QCaObject::disconnectedCount = QCaObject::totalChannelCount - QCaObject::connectedCount;
+//------------------------------------------------------------------------------
+//
+void QCaObject::connectPutCallback ()
+{
+   QObject::connect (this->client, SIGNAL (putCallbackComplete    (const bool)),
+                     this,         SLOT   (putCallbackNotifcation (const bool)),
+                     Qt::UniqueConnection);
+}
+
+//------------------------------------------------------------------------------
+//
+bool QCaObject::isPutCallbackHead () const
+{
+   const QList<QCaObject*> list = putCallbackInitiators.value (this->client);
+   return !list.isEmpty () && (list.first () == this);
+}
+
+//------------------------------------------------------------------------------
+// Records this object as awaiting a put callback from its shared client.
+//
+void QCaObject::addPutCallbackInitiator ()
+{
+   QList<QCaObject*>& list = putCallbackInitiators [this->client];
+   list.append (this);
+   if (list.count () == 1) {
+      this->connectPutCallback ();
+   }
+}
+
+//------------------------------------------------------------------------------
+// Removes this object from its shared client's put callback initiators, and
+// passes the put callback connection on to the next initiator, if any.
+//
+void QCaObject::removePutCallbackInitiator ()
+{
+   QHash<QEBaseClient*, QList<QCaObject*> >::iterator it =
+         putCallbackInitiators.find (this->client);
+   if (it == putCallbackInitiators.end ()) return;
+
+   QList<QCaObject*>& list = it.value ();
+   const bool wasHead = (list.first () == this);
+   list.removeAll (this);
+
+   if (wasHead) {
+      QObject::disconnect (this->client, SIGNAL (putCallbackComplete    (const bool)),
+                           this,         SLOT   (putCallbackNotifcation (const bool)));
+      if (!list.isEmpty ()) {
+         list.first ()->connectPutCallback ();
+      }
+   }
+
+   if (list.isEmpty ()) {
+      putCallbackInitiators.erase (it);
+   }
+}
+
+//------------------------------------------------------------------------------
+// When attaching to a shared channel that is already open, the connection
+// and data updates have already been and gone - replay them for this object.
+//
+void QCaObject::replaySharedState ()
+{
+   this->replayIsPending = false;
+   if (!this->client || !this->clientIsShared || !this->sharedChannelIsOpen) return;
+
+   if (this->client->getIsConnected ()) {
+      this->connectionUpdate (true);
+      if (this->client->dataIsAvailable ()) {
+         this->dataUpdate (true);
+      }
+   }
 }
 
 //------------------------------------------------------------------------------
@@ -269,21 +486,56 @@ void QCaObject::clearConnectionState()
 bool QCaObject::subscribe()
 {
    this->clearConnectionState();
+
+   if (this->clientIsShared) {
+      if (this->sharedChannelIsOpen) return true;   // already subscribed
+
+      // Client signals are disconnected when the channel is closed - ensure
+      // connected exactly once.
+      //
+      QObject::disconnect (this->client, 0, this, 0);
+      this->connectClient ();
+
+      const bool alreadyConnected = this->client->getIsConnected ();
+      const bool result = QEChannelRegistry::openChannel (this->client);
+      this->sharedChannelIsOpen = true;
+
+      // Was the channel already opened by another user?
+      //
+      if (alreadyConnected && !this->replayIsPending) {
+         this->replayIsPending = true;
+         QTimer::singleShot (0, this, SLOT (replaySharedState ()));
+      }
+      return result;
+   }
+
    return this->client->openChannel (QEBaseClient::Monitor | QEBaseClient::Write);
 }
 
 //------------------------------------------------------------------------------
+// Shared clients are only opened in subscribe mode, so revert to a private client.
 //
 bool QCaObject::singleShotRead()
 {
+   if (this->clientIsShared) {
+      this->releaseClient ();
+      this->createPrivateClient ();
+   }
+
    this->clearConnectionState();
    return this->client->openChannel (QEBaseClient::Read | QEBaseClient::Write);
 }
 
 //------------------------------------------------------------------------------
+// Ditto
 //
 bool QCaObject::connectChannel()
 {
+   if (this->clientIsShared) {
+      this->releaseClient ();
+      this->createPrivateClient ();
+   }
+
    this->clearConnectionState();
    return this->client->openChannel (QEBaseClient::Write);
 }
@@ -292,6 +544,24 @@ bool QCaObject::connectChannel()
 //
 void QCaObject::closeChannel()
 {
+   if (this->clientIsShared) {
+      if (this->sharedChannelIsOpen) {
+         // Other users may keep the shared channel open, so stop listening
+         // to the client and report the disconnection on its behalf, as a
+         // private client would when its channel is closed.
+         //
+         const bool wasConnected = this->client->getIsConnected ();
+         this->removePutCallbackInitiator ();
+         QObject::disconnect (this->client, 0, this, 0);
+         QEChannelRegistry::closeChannel (this->client);
+         this->sharedChannelIsOpen = false;
+         if (wasConnected) {
+            this->connectionUpdate (false);
+         }
+      }
+      return;
+   }
+
    this->client->closeChannel();
 }
 
@@ -319,7 +589,12 @@ unsigned int QCaObject::getVariableIndex () const
 void QCaObject::setUserMessage( UserMessage* userMessageIn )
 {
    this->userMessage = userMessageIn;
-   this->client->setUserMessage (userMessageIn);
+
+   // Shared clients are given the user message of the writing object (see writeData).
+   //
+   if (!this->clientIsShared) {
+      this->client->setUserMessage (userMessageIn);
+   }
 }
 
 //------------------------------------------------------------------------------
@@ -329,12 +604,66 @@ void QCaObject::setUserMessage( UserMessage* userMessageIn )
 //
 void  QCaObject::setRequestedElementCount( unsigned int elementCount )
 {
+   const unsigned int previous = this->requestedElementCount;
+   this->requestedElementCount = elementCount;
+
+   if (this->clientIsShared) {
+      // The element count forms part of the shared client key - re-attach if
+      // changed, and re-subscribe if we were subscribed.
+      //
+      if (elementCount == previous) return;
+
+      const bool wasOpen = this->sharedChannelIsOpen;
+      this->releaseClient ();
+      this->attachSharedClient ();
+      if (wasOpen) this->subscribe ();
+      return;
+   }
+
    QECaClient* caClient = this->asCaClient();
    if (caClient) {
       caClient->setRequestCount (elementCount);
    }
 }
 
+//------------------------------------------------------------------------------
+// Like the element count, this can be called before or during a subscription.
+// Private clients apply the request when the channel is next opened.
+//
+void QCaObject::setPvRequest( const QString& pvRequest )
+{
+   if (this->pvNameUri.getProtocol () != QEPvNameUri::pva) return;
+
+   const QString request = pvRequest.trimmed ();
+   const QString effective = request.isEmpty () ? this->uriPvRequest : request;
+   if (effective == this->pvNameUri.getPvRequest ()) return;   // no change
+
+   this->pvNameUri.setPvRequest (effective);
+
+   if (this->clientIsShared) {
+      // The request forms part of the shared client key - re-attach, and
+      // re-subscribe if we were subscribed.
+      //
+      const bool wasOpen = this->sharedChannelIsOpen;
+      this->releaseClient ();
+      this->attachSharedClient ();
+      if (wasOpen) this->subscribe ();
+      return;
+   }
+
+   QEPvaClient* pvaClient = this->asPvaClient();
+   if (pvaClient) {
+      pvaClient->setPvRequest (effective);
+   }
+}
+
+//------------------------------------------------------------------------------
+//
+QString QCaObject::getPvRequest() const
+{
+   return this->pvNameUri.getPvRequest ();
+}
+
 //------------------------------------------------------------------------------
 // Extract last emmited connection info: indicates if channel is connected.
 //
@@ -712,6 +1041,12 @@ double  QCaObject::getControlLimitLower() const
 //
 void QCaObject::enableWriteCallbacks( bool enable )
 {
+   this->usePutCallback = enable;
+
+   // Shared clients are set up on each write (see writeData).
+   //
+   if (this->clientIsShared) return;
+
    QECaClient* caClient = this->asCaClient();
    if (caClient)
       caClient->setUsePutCallback( enable );
@@ -722,6 +1057,10 @@ void QCaObject::enableWriteCallbacks( bool enable )
 //
 bool QCaObject::isWriteCallbacksEnabled() const
 {
+   if (this->clientIsShared) {
+      return this->isCaChannel() && this->usePutCallback;
+   }
+
    QECaClient* caClient = this->asCaClient();
    if (caClient)
       return caClient->getUsePutCallback();
@@ -760,6 +1099,10 @@ void QCaObject::connectionUpdate (const bool isConnected)
 {
    QCaConnectionInfo connectionInfo;
 
+   // Any held back data update preceeded this connection change - deliver it first.
+   //
+   this->flushPendingUpdate ();
+
    if (isConnected) {
       connectionInfo = QCaConnectionInfo( QCaConnectionInfo::CONNECTED,
                                           QCaConnectionInfo::LINK_UP,
@@ -770,6 +1113,12 @@ void QCaObject::connectionUpdate (const bool isConnected)
                                           QCaConnectionInfo::LINK_DOWN,
                                           this->recordName );
       QCaObject::connectedCount--;
+
+      // Outstanding put callbacks will not complete.
+      //
+      if (this->clientIsShared) {
+         this->removePutCallbackInitiator ();
+      }
    }
 
    QCaObject::connectedCount = LIMIT (QCaObject::connectedCount, 0, QCaObject::totalChannelCount);
@@ -779,9 +1128,47 @@ void QCaObject::connectionUpdate (const bool isConnected)
 }
 
 //------------------------------------------------------------------------------
-// New data available - emit to awaiting objects.
+// New data available - emit to awaiting objects, subject to the maximum update rate.
+// When rate limited, held back updates are coalesced: as the client only retains the
+// latest value, the latest value wins when the coalesce timer expires.
+// First updates and alarm state changes are always emitted immediately.
 //
 void QCaObject::dataUpdate (const bool firstUpdateIn)
+{
+   if (!this->client) return;   // sanity check
+
+   // Value deadband - the update is dropped, not deferred.
+   //
+   if (!firstUpdateIn && this->isWithinDeadband ()) return;
+
+   if (this->minimumInterval > 0 && !firstUpdateIn &&
+       this->lastEmitTime.isValid () &&
+       this->client->getAlarmInfo () == this->lastEmitAlarm)
+   {
+      const qint64 elapsed = this->lastEmitTime.elapsed ();
+      if (elapsed < this->minimumInterval) {
+         this->updatePending = true;
+         if (!this->coalesceTimer) {
+            this->coalesceTimer = new QTimer (this);
+            this->coalesceTimer->setSingleShot (true);
+            QObject::connect (this->coalesceTimer, SIGNAL (timeout ()),
+                              this,                SLOT   (coalesceTimeout ()));
+         }
+         if (!this->coalesceTimer->isActive ()) {
+            this->coalesceTimer->start (int (this->minimumInterval - elapsed));
+         }
+         return;
+      }
+   }
+
+   this->firstUpdate = firstUpdateIn;
+   this->emitDataChanged ();
+}
+
+//------------------------------------------------------------------------------
+// Emit the latest data to awaiting objects.
+//
+void QCaObject::emitDataChanged ()
 {
    static const char* varSignal =
          SIGNAL (dataChanged (const QVariant&, QCaAlarmInfo&, QCaDateTime&,
@@ -796,10 +1183,17 @@ void QCaObject::dataUpdate (const bool firstUpdateIn)
 
    if (!this->client) return;   // sanity check
 
+   // Whatever was pending is superseded by this emit.
+   //
+   this->updatePending = false;
+   if (this->coalesceTimer) this->coalesceTimer->stop ();
+
    alarmInfo = this->client->getAlarmInfo ();
    timeStamp = this->client->getTimeStamp ();
 
-   this->firstUpdate = firstUpdateIn;
+   this->lastEmitAlarm = alarmInfo;
+   this->lastEmitTime.start ();
+   this->lastEmitValueIsValid = this->getScalarValue (this->lastEmitValue);
 
    if (this->signalsToSend & SIG_VARIANT) {
       // Only form variant and emit signal if at least one receiver.
@@ -827,11 +1221,216 @@ void QCaObject::dataUpdate (const bool firstUpdateIn)
    }
 }
 
+//------------------------------------------------------------------------------
+// Emit any held back data update now.
+//
+void QCaObject::flushPendingUpdate ()
+{
+   if (this->updatePending) {
+      this->firstUpdate = false;
+      this->emitDataChanged ();
+   }
+}
+
+//------------------------------------------------------------------------------
+//
+void QCaObject::coalesceTimeout ()
+{
+   this->flushPendingUpdate ();
+}
+
+//------------------------------------------------------------------------------
+//
+void QCaObject::setMaximumUpdateRate (const double rate)
+{
+   this->maximumUpdateRate = MAX (rate, 0.0);
+   this->calcMinimumInterval ();
+}
+
+//------------------------------------------------------------------------------
+//
+double QCaObject::getMaximumUpdateRate () const
+{
+   return this->maximumUpdateRate;
+}
+
+//------------------------------------------------------------------------------
+//
+void QCaObject::setMinimumUpdateInterval (const int interval)
+{
+   this->minimumUpdateInterval = MAX (interval, 0);
+   this->calcMinimumInterval ();
+}
+
+//------------------------------------------------------------------------------
+//
+int QCaObject::getMinimumUpdateInterval () const
+{
+   return this->minimumUpdateInterval;
+}
+
+//------------------------------------------------------------------------------
+// The more restrictive of the maximum update rate and minimum update interval applies.
+//
+void QCaObject::calcMinimumInterval ()
+{
+   qint64 interval = this->minimumUpdateInterval;
+   if (this->maximumUpdateRate > 0.0) {
+      // Round up to at least 1 mSec
+      const qint64 rateInterval = MAX (qint64 (1000.0 / this->maximumUpdateRate + 0.5), 1);
+      interval = MAX (interval, rateInterval);
+   }
+
+   this->minimumInterval = interval;
+   if (this->minimumInterval == 0) {
+      this->flushPendingUpdate ();
+   }
+}
+
+//------------------------------------------------------------------------------
+//
+void QCaObject::setAbsoluteDeadband (const double deadband)
+{
+   this->absoluteDeadband = MAX (deadband, 0.0);
+}
+
+//------------------------------------------------------------------------------
+//
+double QCaObject::getAbsoluteDeadband () const
+{
+   return this->absoluteDeadband;
+}
+
+//------------------------------------------------------------------------------
+//
+void QCaObject::setRelativeDeadband (const double percent)
+{
+   this->relativeDeadband = MAX (percent, 0.0);
+}
+
+//------------------------------------------------------------------------------
+//
+double QCaObject::getRelativeDeadband () const
+{
+   return this->relativeDeadband;
+}
+
+//------------------------------------------------------------------------------
+//
+void QCaObject::setAutoDeadband (const bool autoDeadbandIn)
+{
+   this->autoDeadband = autoDeadbandIn;
+}
+
+//------------------------------------------------------------------------------
+//
+bool QCaObject::getAutoDeadband () const
+{
+   return this->autoDeadband;
+}
+
+//------------------------------------------------------------------------------
+// virtual
+double QCaObject::getAutoDeadbandValue () const
+{
+   return 0.0;
+}
+
+//------------------------------------------------------------------------------
+// Extracts a scalar numeric value, if any, from the client's current data.
+//
+bool QCaObject::getScalarValue (double& value) const
+{
+   if (!this->client || !this->client->dataIsAvailable ()) return false;
+   if (this->client->dataElementCount () != 1) return false;
+
+   const QVariant data = this->client->getPvData ();
+   switch (data.type ()) {
+      case QVariant::Double:
+      case QVariant::Int:
+      case QVariant::UInt:
+      case QVariant::LongLong:
+      case QVariant::ULongLong:
+      case QVariant::Bool:
+         break;
+
+      default:
+         if (QMetaType::Type (data.type ()) == QMetaType::Float) break;
+         return false;     // strings, arrays etc.
+   }
+
+   bool okay;
+   value = data.toDouble (&okay);
+   return okay;
+}
+
+//------------------------------------------------------------------------------
+// Returns true if the new data is within the deadband of the last emitted data.
+// The alarm state must also be unchanged.
+//
+bool QCaObject::isWithinDeadband () const
+{
+   if (!this->lastEmitValueIsValid) return false;
+
+   const double resolution = this->autoDeadband ? this->getAutoDeadbandValue () : 0.0;
+
+   if ((this->absoluteDeadband <= 0.0) && (this->relativeDeadband <= 0.0) &&
+       (resolution <= 0.0)) return false;   // no deadband
+
+   if (this->client->getAlarmInfo () != this->lastEmitAlarm) return false;
+
+   double value;
+   if (!this->getScalarValue (value)) return false;
+
+   // NaN values always emitted - comparisons below fail.
+   //
+   // Auto deadband - compare the values as displayed, i.e. rounded to the least
+   // significant displayed digit, rather than the difference. Comparing the raw
+   // difference would drop 1.06 after 1.04 at one decimal place although the
+   // displayed value changes from 1.0 to 1.1.
+   //
+   if (resolution > 0.0) {
+      const double digit = 2.0 * resolution;
+      if (floor (value / digit + 0.5) == floor (this->lastEmitValue / digit + 0.5)) return true;
+   }
+
+   const double delta = ABS (value - this->lastEmitValue);
+
+   if (delta <= this->absoluteDeadband) return true;
+
+   const double relative = ABS (this->lastEmitValue) * this->relativeDeadband / 100.0;
+   if (delta <= relative) return true;
+
+   return false;
+}
+
 //------------------------------------------------------------------------------
 // Putcallback notification.
 //
 void QCaObject::putCallbackNotifcation( const bool isSuccessful )
 {
+   // Shared clients - this object is the initiator at the head of the list.
+   // Hand over to the next initiator, if any.
+   //
+   if (this->clientIsShared) {
+      QHash<QEBaseClient*, QList<QCaObject*> >::iterator it =
+            putCallbackInitiators.find (this->client);
+      if (it == putCallbackInitiators.end () || it.value ().first () != this) return;
+
+      QList<QCaObject*>& list = it.value ();
+      list.removeFirst ();
+      if (list.isEmpty ()) {
+         putCallbackInitiators.erase (it);
+      }
+      if (!this->isPutCallbackHead ()) {
+         QObject::disconnect (this->client, SIGNAL (putCallbackComplete    (const bool)),
+                              this,         SLOT   (putCallbackNotifcation (const bool)));
+         if (putCallbackInitiators.contains (this->client)) {
+            putCallbackInitiators.value (this->client).first ()->connectPutCallback ();
+         }
+      }
+   }
+
    qDebug () << __FUNCTION__ << this->getRecordName() << isSuccessful;
 }
 
@@ -878,6 +1477,23 @@ void QCaObject::getLastData( bool& isDefinedOut, QVariant& valueOut,
 bool QCaObject::writeData( const QVariant& value )
 {
    if (!this->client) return false;   // sanity check
+
+   // A shared client uses the put settings of the object doing the writing.
+   //
+   if (this->clientIsShared) {
+      this->client->setUserMessage (this->userMessage);
+      QECaClient* caClient = this->asCaClient();
+      if (caClient) {
+         caClient->setUsePutCallback (this->usePutCallback);
+      }
+
+      const bool result = this->client->putPvData (value);
+      if (result && caClient && this->usePutCallback) {
+         this->addPutCallbackInitiator ();
+      }
+      return result;
+   }
+
    return this->client->putPvData (value);
 }
 
@@ -891,6 +1507,13 @@ bool QCaObject::writeDataElement( const QVariant& elementValue )
 
    bool result;
 
+   // Own vector variants are converted to a list - this is not a time critical function.
+   //
+   if( QEVectorVariants::isVectorVariant( lastVariantValue ) ) {
+      bool okay;
+      lastVariantValue = QEVectorVariants::convertToVariantList( lastVariantValue, okay );
+   }
+
    if( lastVariantValue.type() == QVariant::List ) {
       QVariantList valueList = lastVariantValue.toList ();
       if( ( this->arrayIndex >= 0 ) && ( this->arrayIndex < valueList.size() ) )
@@ -919,7 +1542,8 @@ bool QCaObject::writeDataElement( const QVariant& elementValue )
 void QCaObject::resendLastData()
 {
    if( this->getDataIsAvailable() ){
-      this->dataUpdate( false );
+      this->firstUpdate = false;
+      this->emitDataChanged();     // not subject to rate limiting
    }
 }
 
@@ -31,16 +31,19 @@
 #include <QString>
 #include <QFlags>
 #include <QVariant>
+#include <QElapsedTimer>
 
 #include <UserMessage.h>
 #include <QCaAlarmInfo.h>
 #include <QCaDateTime.h>
 #include <QCaConnectionInfo.h>
 #include <QEBaseClient.h>
+#include <QEPvNameUri.h>
 #include <QEFrameworkLibraryGlobal.h>
 
 // differed, so we don't need to include headers
 //
+class QTimer;
 class QECaClient;
 class QEPvaClient;
 
@@ -114,6 +117,56 @@ public:
 
    void setRequestedElementCount( unsigned int elementCount );
 
+   // Set/get the PV Access get/monitor pvRequest, e.g. "field(value,alarm,timeStamp)"
+   // or "record[queueSize=4,pipeline=true]". This overrides any request specified
+   // as part of the PV name URI. An empty request reverts to the URI request, if any.
+   // Not applicable to CA channels.
+   //
+   void setPvRequest( const QString& pvRequest );
+   QString getPvRequest() const;
+
+   // Set/get the maximum rate (Hz) at which dataChanged signals are emitted.
+   // Updates arriving faster than this are coalesced, i.e. the latest value wins.
+   // Alarm state changes and connection changes are never held back.
+   // Zero (or less) means unlimited.
+   //
+   void setMaximumUpdateRate( const double rate );
+   double getMaximumUpdateRate() const;
+
+   // The application default maximum update rate. Each QCaObject takes this as
+   // its initial maximum update rate when constructed, so it applies to all
+   // objects whether or not they are managed on behalf of a widget; changing the
+   // default does not affect existing objects. Initialised from the
+   // QE_MAX_UPDATE_RATE adaptation parameter, and defaults to 0, i.e. unlimited.
+   //
+   static void setDefaultMaximumUpdateRate( const double rate );
+   static double getDefaultMaximumUpdateRate();
+
+   // Client side deadbands. These only apply to scalar numeric data. A data update
+   // is not emitted if the value has changed from the last emitted value by no more
+   // than the absolute deadband, or by no more than the relative deadband (percent
+   // of the last emitted value). First updates and alarm state changes are always
+   // emitted. Zero (the default) disables each deadband.
+   // When auto deadband is set, an update is also not emitted if it would be
+   // displayed the same as the last emitted value, i.e. both values round to the
+   // same multiple of the displayed resolution provided by getAutoDeadbandValue,
+   // which the QEString sub-class bases on its formatting precision.
+   //
+   void setAbsoluteDeadband( const double deadband );
+   double getAbsoluteDeadband() const;
+
+   void setRelativeDeadband( const double percent );
+   double getRelativeDeadband() const;
+
+   void setAutoDeadband( const bool autoDeadband );
+   bool getAutoDeadband() const;
+
+   // Time deadband - minimum interval (mSec) between emitted data updates.
+   // This is combined with the maximum update rate, the more restrictive applies.
+   //
+   void setMinimumUpdateInterval( const int interval );
+   int getMinimumUpdateInterval() const;
+
    // Get database information relating to the variable
    QString getRecordName() const;
    QString getEgu() const;
@@ -185,6 +238,12 @@ public:
    static ObjectIdentity nullObjectIdentity ();    // provides the null identifier value
    ObjectIdentity getObjectIdentity () const;
 
+protected:
+   // Sub-classes may provide an automatic deadband, i.e. half of the least significant
+   // displayed digit. Default returns 0.0, i.e. none.
+   //
+   virtual double getAutoDeadbandValue() const;
+
 signals:
    void dataChanged( const QVariant& value, QCaAlarmInfo& alarmInfo, QCaDateTime& timeStamp, const unsigned int& variableIndex );
    void dataChanged( const QByteArray& value, unsigned long dataSize, QCaAlarmInfo& alarmInfo, QCaDateTime& timeStamp, const unsigned int& variableIndex );
@@ -213,6 +272,21 @@ private:
    QECaClient* asCaClient () const;
    QEPvaClient* asPvaClient () const;
 
+   // Client management. Clients are either private, i.e. owned by this object,
+   // or shared, i.e. owned by the QEChannelRegistry.
+   //
+   void createPrivateClient ();
+   void attachSharedClient ();
+   void releaseClient ();
+   void connectClient ();
+
+   // Put callback routing for shared clients.
+   //
+   void connectPutCallback ();
+   bool isPutCallbackHead () const;
+   void addPutCallbackInitiator ();
+   void removePutCallbackInitiator ();
+
    // Clear the connection state - and signal
    //
    void clearConnectionState();
@@ -227,10 +301,42 @@ private:
    // This can be one of QECaClient, QEPvaClient or QENullClient.
    //
    QEBaseClient* client;
+   bool clientIsShared;           // client is owned by the QEChannelRegistry
+   bool sharedChannelIsOpen;      // this object has opened the shared channel
+   bool replayIsPending;          // replaySharedState has been queued
+   QEPvNameUri pvNameUri;         // decoded record name
+   QString uriPvRequest;          // pva request as originally specified in the record name
+   priorities priority;
+   unsigned int requestedElementCount;
+   bool usePutCallback;           // only used for shared clients
 
    QVariant getVariant () const;
    QByteArray getByteArray () const;
 
+   // Update rate limiting.
+   //
+   void emitDataChanged ();
+   void flushPendingUpdate ();
+   void calcMinimumInterval ();
+   bool getScalarValue (double& value) const;
+   bool isWithinDeadband () const;
+
+   double maximumUpdateRate;      // Hz, <= 0 means unlimited
+   int minimumUpdateInterval;     // mSec, time deadband
+   qint64 minimumInterval;        // mSec, derived from maximumUpdateRate and minimumUpdateInterval
+   double absoluteDeadband;
+   double relativeDeadband;       // percent
+   bool autoDeadband;
+   double lastEmitValue;          // last emitted scalar value, if any
+   bool lastEmitValueIsValid;
+   QElapsedTimer lastEmitTime;    // time of the last dataChanged emit
+   QCaAlarmInfo lastEmitAlarm;    // alarm state of the last dataChanged emit
+   QTimer* coalesceTimer;         // created on demand
+   bool updatePending;            // an update has been held back
+
+   static double defaultMaximumUpdateRate;
+   static bool defaultMaximumUpdateRateIsSet;
+
    quint64 objectIdentity;   // this object's identity
    static ObjectIdentity nextObjectIdentity;
    
@@ -239,8 +345,10 @@ private:
    static int totalChannelCount;
 
 private slots:
+   void replaySharedState ();
    void connectionUpdate (const bool isConnected);
    void dataUpdate (const bool firstUpdate);
+   void coalesceTimeout ();
    void putCallbackNotifcation (const bool isSuccessful);
 };
 
@@ -105,16 +105,44 @@ void QEFloating::writeFloating( const QVector<double> &data )
 void QEFloating::convertVariant( const QVariant &value, QCaAlarmInfo& alarmInfo,
                                  QCaDateTime& timeStamp, const unsigned int& variableIndex )
 {
-   if( ( value.type() == QVariant::List ) || QEVectorVariants::isVectorVariant( value ) )
+   // Only form the array and emit the array signal if at least one receiver.
+   // Forming the array is O(n), which is wasted when only the element at the
+   // array index is used, e.g. by a single element widget on a large waveform.
+   //
+   static const char* arraySignal =
+         SIGNAL( floatingArrayChanged( const QVector<double>&, QCaAlarmInfo&, QCaDateTime&, const unsigned int& ) );
+   const bool arrayRequired = ( this->receivers( arraySignal ) > 0 );
+
+   const int ai = getArrayIndex();
+
+   if( QEVectorVariants::isVectorVariant( value ) )
    {
-      emit floatingArrayChanged( floatingFormat->formatFloatingArray( value ),
-                                 alarmInfo, timeStamp, variableIndex );
+      // Vector variants, e.g. as delivered for CA and PVA numeric arrays,
+      // provide typed element access - no intermediate QVariantList.
+      //
+      if( arrayRequired ) {
+         emit floatingArrayChanged( floatingFormat->formatFloatingArray( value ),
+                                    alarmInfo, timeStamp, variableIndex );
+      }
 
-      int ai = getArrayIndex();
-      if( ai >= 0 && ai < value.toList().count() ) {
+      if( ai >= 0 && ai < QEVectorVariants::vectorCount( value ) ) {
          // Convert this array element as a scalar update.
-         const double item = floatingFormat->formatFloating( value.toList().value( ai ) );
-         emit floatingChanged(item, alarmInfo, timeStamp, variableIndex );
+         const double item = floatingFormat->formatFloating( value, ai );
+         emit floatingChanged( item, alarmInfo, timeStamp, variableIndex );
+      }
+   }
+   else if( value.type() == QVariant::List )
+   {
+      if( arrayRequired ) {
+         emit floatingArrayChanged( floatingFormat->formatFloatingArray( value ),
+                                    alarmInfo, timeStamp, variableIndex );
+      }
+
+      const QVariantList list = value.toList();
+      if( ai >= 0 && ai < list.count() ) {
+         // Convert this array element as a scalar update.
+         const double item = floatingFormat->formatFloating( list.value( ai ) );
+         emit floatingChanged( item, alarmInfo, timeStamp, variableIndex );
       }
    }
    else
@@ -124,10 +152,12 @@ void QEFloating::convertVariant( const QVariant &value, QCaAlarmInfo& alarmInfo,
 
       // A scalar is also an array with one element.
       //
-      QVariantList array;
-      array.append (value);
-      emit floatingArrayChanged( floatingFormat->formatFloatingArray( array ),
-                                 alarmInfo, timeStamp, variableIndex );
+      if( arrayRequired ) {
+         QVariantList array;
+         array.append (value);
+         emit floatingArrayChanged( floatingFormat->formatFloatingArray( array ),
+                                    alarmInfo, timeStamp, variableIndex );
+      }
    }
 }
 
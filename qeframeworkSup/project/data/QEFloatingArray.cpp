@@ -25,12 +25,239 @@
  */
 
 #include "QEFloatingArray.h"
+#include <math.h>
 #include <algorithm>
+#include <vector>
 #include <QDebug>
 #include <QtAlgorithms>
 #include <QECommon.h>
 #include <QEPlatform.h>
 
+#ifdef QE_SIMD_X86
+#include <immintrin.h>
+#endif
+
+#define MIN_DELTA_X  (1.0E-20)
+
+//=================================================================================
+// Array kernels. The SIMD kernels process the bulk of the array and return the
+// number of elements processed, the remainder being processed by the scalar
+// kernel. The SIMD and scalar kernels use the same rules and, for dy/dx, the
+// same arithmetic so that the results are identical.
+//=================================================================================
+//
+static void scalarSummary (const double* data, const int first, const int number,
+                           const bool includeInf, QEFloatingArray::Summary& summary)
+{
+   for (int j = first; j < number; j++) {
+      const double v = data [j];
+
+      // Ignore nan values, and only include inf if requested
+      //
+      if (QEPlatform::isNaN (v)) {
+         summary.nanCount++;
+         continue;
+      }
+      if (!includeInf && QEPlatform::isInf (v)) continue;
+
+      summary.minimum = MIN (summary.minimum, v);
+      summary.maximum = MAX (summary.maximum, v);
+      summary.sum += v;
+      summary.count++;
+   }
+}
+
+//---------------------------------------------------------------------------------
+//
+static void scalarDyByDx (const double* x, const double* y, const int first,
+                          const int last, double* result)
+{
+   for (int j = first; j <= last; j++) {
+      const double x1 = x [j - 1] - x [j];
+      const double y1 = y [j - 1] - y [j];
+      const double x3 = x [j + 1] - x [j];
+      const double y3 = y [j + 1] - y [j];
+      const double divisor = x1*x3*(x3 - x1);
+      result [j] = (ABS (divisor) >= MIN_DELTA_X) ? (y1*x3*x3 - y3*x1*x1) / divisor : 0.0;
+   }
+}
+
+#ifdef QE_SIMD_X86
+
+//---------------------------------------------------------------------------------
+//
+QE_TARGET_SSE2
+static int sse2Summary (const double* data, const int number,
+                        const bool includeInf, QEFloatingArray::Summary& summary)
+{
+   const int processed = number & ~1;
+   if (processed == 0) return 0;
+
+   const __m128d absMask = _mm_castsi128_pd (_mm_set1_epi64x (0x7FFFFFFFFFFFFFFFLL));
+   const __m128d posInf = _mm_set1_pd (+HUGE_VAL);
+   const __m128d negInf = _mm_set1_pd (-HUGE_VAL);
+
+   // NaN never compares equal, so when inf is included nothing is excluded as inf.
+   //
+   const __m128d infLimit = includeInf ? _mm_set1_pd (NAN) : posInf;
+
+   __m128d vmin = posInf;
+   __m128d vmax = negInf;
+   __m128d vsum = _mm_setzero_pd ();
+   __m128i vexcluded = _mm_setzero_si128 ();
+   __m128i vnan = _mm_setzero_si128 ();
+
+   for (int j = 0; j < processed; j += 2) {
+      const __m128d v = _mm_loadu_pd (data + j);
+      const __m128d isNan = _mm_cmpunord_pd (v, v);
+      const __m128d exclude = _mm_or_pd (isNan, _mm_cmpeq_pd (_mm_and_pd (v, absMask), infLimit));
+
+      // Excluded values are replaced by the identity value of each operation.
+      //
+      const __m128d forMin = _mm_or_pd (_mm_and_pd (exclude, posInf), _mm_andnot_pd (exclude, v));
+      const __m128d forMax = _mm_or_pd (_mm_and_pd (exclude, negInf), _mm_andnot_pd (exclude, v));
+
+      vmin = _mm_min_pd (vmin, forMin);
+      vmax = _mm_max_pd (vmax, forMax);
+      vsum = _mm_add_pd (vsum, _mm_andnot_pd (exclude, v));
+
+      // Comparison results are all ones, i.e. -1, for true.
+      //
+      vexcluded = _mm_sub_epi64 (vexcluded, _mm_castpd_si128 (exclude));
+      vnan = _mm_sub_epi64 (vnan, _mm_castpd_si128 (isNan));
+   }
+
+   double mins [2], maxs [2], sums [2];
+   qint64 excluded [2], nans [2];
+   _mm_storeu_pd (mins, vmin);
+   _mm_storeu_pd (maxs, vmax);
+   _mm_storeu_pd (sums, vsum);
+   _mm_storeu_si128 ((__m128i*) excluded, vexcluded);
+   _mm_storeu_si128 ((__m128i*) nans, vnan);
+
+   for (int k = 0; k < 2; k++) {
+      summary.minimum = MIN (summary.minimum, mins [k]);
+      summary.maximum = MAX (summary.maximum, maxs [k]);
+      summary.sum += sums [k];
+      summary.count -= int (excluded [k]);
+      summary.nanCount += int (nans [k]);
+   }
+   summary.count += processed;
+
+   return processed;
+}
+
+//---------------------------------------------------------------------------------
+//
+QE_TARGET_AVX2
+static int avx2Summary (const double* data, const int number,
+                        const bool includeInf, QEFloatingArray::Summary& summary)
+{
+   const int processed = number & ~3;
+   if (processed == 0) return 0;
+
+   const __m256d absMask = _mm256_castsi256_pd (_mm256_set1_epi64x (0x7FFFFFFFFFFFFFFFLL));
+   const __m256d posInf = _mm256_set1_pd (+HUGE_VAL);
+   const __m256d negInf = _mm256_set1_pd (-HUGE_VAL);
+   const __m256d infLimit = includeInf ? _mm256_set1_pd (NAN) : posInf;
+
+   __m256d vmin = posInf;
+   __m256d vmax = negInf;
+   __m256d vsum = _mm256_setzero_pd ();
+   __m256i vexcluded = _mm256_setzero_si256 ();
+   __m256i vnan = _mm256_setzero_si256 ();
+
+   for (int j = 0; j < processed; j += 4) {
+      const __m256d v = _mm256_loadu_pd (data + j);
+      const __m256d isNan = _mm256_cmp_pd (v, v, _CMP_UNORD_Q);
+      const __m256d isInf = _mm256_cmp_pd (_mm256_and_pd (v, absMask), infLimit, _CMP_EQ_OQ);
+      const __m256d exclude = _mm256_or_pd (isNan, isInf);
+
+      vmin = _mm256_min_pd (vmin, _mm256_blendv_pd (v, posInf, exclude));
+      vmax = _mm256_max_pd (vmax, _mm256_blendv_pd (v, negInf, exclude));
+      vsum = _mm256_add_pd (vsum, _mm256_andnot_pd (exclude, v));
+
+      vexcluded = _mm256_sub_epi64 (vexcluded, _mm256_castpd_si256 (exclude));
+      vnan = _mm256_sub_epi64 (vnan, _mm256_castpd_si256 (isNan));
+   }
+
+   double mins [4], maxs [4], sums [4];
+   qint64 excluded [4], nans [4];
+   _mm256_storeu_pd (mins, vmin);
+   _mm256_storeu_pd (maxs, vmax);
+   _mm256_storeu_pd (sums, vsum);
+   _mm256_storeu_si256 ((__m256i*) excluded, vexcluded);
+   _mm256_storeu_si256 ((__m256i*) nans, vnan);
+
+   for (int k = 0; k < 4; k++) {
+      summary.minimum = MIN (summary.minimum, mins [k]);
+      summary.maximum = MAX (summary.maximum, maxs [k]);
+      summary.sum += sums [k];
+      summary.count -= int (excluded [k]);
+      summary.nanCount += int (nans [k]);
+   }
+   summary.count += processed;
+
+   return processed;
+}
+
+//---------------------------------------------------------------------------------
+// Middle points only, i.e. 1 .. last. Returns the next point to be processed.
+//
+QE_TARGET_SSE2
+static int sse2DyByDx (const double* x, const double* y, const int last, double* result)
+{
+   const __m128d absMask = _mm_castsi128_pd (_mm_set1_epi64x (0x7FFFFFFFFFFFFFFFLL));
+   const __m128d minDelta = _mm_set1_pd (MIN_DELTA_X);
+
+   int j = 1;
+   for (; j + 1 <= last; j += 2) {
+      const __m128d xp2 = _mm_loadu_pd (x + j);
+      const __m128d yp2 = _mm_loadu_pd (y + j);
+      const __m128d x1 = _mm_sub_pd (_mm_loadu_pd (x + j - 1), xp2);
+      const __m128d y1 = _mm_sub_pd (_mm_loadu_pd (y + j - 1), yp2);
+      const __m128d x3 = _mm_sub_pd (_mm_loadu_pd (x + j + 1), xp2);
+      const __m128d y3 = _mm_sub_pd (_mm_loadu_pd (y + j + 1), yp2);
+
+      const __m128d divisor = _mm_mul_pd (_mm_mul_pd (x1, x3), _mm_sub_pd (x3, x1));
+      const __m128d dividend = _mm_sub_pd (_mm_mul_pd (_mm_mul_pd (y1, x3), x3),
+                                           _mm_mul_pd (_mm_mul_pd (y3, x1), x1));
+      const __m128d okay = _mm_cmpge_pd (_mm_and_pd (divisor, absMask), minDelta);
+
+      _mm_storeu_pd (result + j, _mm_and_pd (okay, _mm_div_pd (dividend, divisor)));
+   }
+   return j;
+}
+
+//---------------------------------------------------------------------------------
+//
+QE_TARGET_AVX2
+static int avx2DyByDx (const double* x, const double* y, const int last, double* result)
+{
+   const __m256d absMask = _mm256_castsi256_pd (_mm256_set1_epi64x (0x7FFFFFFFFFFFFFFFLL));
+   const __m256d minDelta = _mm256_set1_pd (MIN_DELTA_X);
+
+   int j = 1;
+   for (; j + 3 <= last; j += 4) {
+      const __m256d xp2 = _mm256_loadu_pd (x + j);
+      const __m256d yp2 = _mm256_loadu_pd (y + j);
+      const __m256d x1 = _mm256_sub_pd (_mm256_loadu_pd (x + j - 1), xp2);
+      const __m256d y1 = _mm256_sub_pd (_mm256_loadu_pd (y + j - 1), yp2);
+      const __m256d x3 = _mm256_sub_pd (_mm256_loadu_pd (x + j + 1), xp2);
+      const __m256d y3 = _mm256_sub_pd (_mm256_loadu_pd (y + j + 1), yp2);
+
+      const __m256d divisor = _mm256_mul_pd (_mm256_mul_pd (x1, x3), _mm256_sub_pd (x3, x1));
+      const __m256d dividend = _mm256_sub_pd (_mm256_mul_pd (_mm256_mul_pd (y1, x3), x3),
+                                              _mm256_mul_pd (_mm256_mul_pd (y3, x1), x1));
+      const __m256d okay = _mm256_cmp_pd (_mm256_and_pd (divisor, absMask), minDelta, _CMP_GE_OQ);
+
+      _mm256_storeu_pd (result + j, _mm256_and_pd (okay, _mm256_div_pd (dividend, divisor)));
+   }
+   return j;
+}
+
+#endif  // QE_SIMD_X86
+
 //=================================================================================
 // QEFloatingArray
 //=================================================================================
@@ -57,54 +284,63 @@ QEFloatingArray& QEFloatingArray::operator=( const  QVector<double>& other )
 
 //---------------------------------------------------------------------------------
 //
-double QEFloatingArray::minimumValue (const double& defaultValue, const bool includeInf)
+QEFloatingArray::Summary QEFloatingArray::summary (const bool includeInf) const
 {
+   const double* data = this->constData ();
    const int n = this->count ();
 
-   double result = defaultValue;
-   bool isFirst = true;
-   for (int j = 0; j < n; j++) {
-      const double v = this->value (j);
-
-      // Ignore nan values, and only include inf if requested
-      //
-      if (QEPlatform::isNaN (v)) continue;
-      if (!includeInf && QEPlatform::isInf (v)) continue;
-
-      if (isFirst) {
-         result = v;
-         isFirst = false;
-      } else {
-         result = MIN (result, v);   // not first, so must merge
-      }
+   Summary result;
+   result.minimum = +HUGE_VAL;
+   result.maximum = -HUGE_VAL;
+   result.sum = 0.0;
+   result.count = 0;
+   result.nanCount = 0;
+
+   int processed = 0;
+
+#ifdef QE_SIMD_X86
+   switch (QEPlatform::simdLevel ()) {
+      case QEPlatform::simdAvx2:
+         processed = avx2Summary (data, n, includeInf, result);
+         break;
+      case QEPlatform::simdSse2:
+         processed = sse2Summary (data, n, includeInf, result);
+         break;
+      default:
+         break;
    }
+#endif
+
+   scalarSummary (data, processed, n, includeInf, result);
    return result;
 }
 
 //---------------------------------------------------------------------------------
 //
-double QEFloatingArray::maximumValue (const double& defaultValue, const bool includeInf)
+bool QEFloatingArray::minMaxValues (double& min, double& max, const bool includeInf) const
 {
-   const int n = this->count ();
+   const Summary s = this->summary (includeInf);
+   if (s.count == 0) return false;
 
-   double result = defaultValue;
-   bool isFirst = true;
-   for (int j = 0; j < n; j++) {
-      const double v = this->value (j);
+   min = s.minimum;
+   max = s.maximum;
+   return true;
+}
 
-      // Ignore nan values, and only include inf if requested
-      //
-      if (QEPlatform::isNaN (v)) continue;
-      if (!includeInf && QEPlatform::isInf (v)) continue;
+//---------------------------------------------------------------------------------
+//
+double QEFloatingArray::minimumValue (const double& defaultValue, const bool includeInf)
+{
+   const Summary s = this->summary (includeInf);
+   return (s.count > 0) ? s.minimum : defaultValue;
+}
 
-      if (isFirst) {
-         result = v;
-         isFirst = false;
-      } else {
-         result = MAX (result, v);   // not first, so must merge
-      }
-   }
-   return result;
+//---------------------------------------------------------------------------------
+//
+double QEFloatingArray::maximumValue (const double& defaultValue, const bool includeInf)
+{
+   const Summary s = this->summary (includeInf);
+   return (s.count > 0) ? s.maximum : defaultValue;
 }
 
 //---------------------------------------------------------------------------------
@@ -114,9 +350,6 @@ QEFloatingArray QEFloatingArray::calcDyByDx (const QVector<double>& x)
    const int size = MIN (this->size(), x.size());
    QEFloatingArray result;
    double s;
-   int j;
-
-   result.clear ();
 
    if (size == 1) {
       result.append (0.0);
@@ -130,73 +363,225 @@ QEFloatingArray QEFloatingArray::calcDyByDx (const QVector<double>& x)
       result.append (s);
 
    } else if (size >= 3) {
+      result.resize (size);
+
+      const double* xData = x.constData ();
+      const double* yData = this->constData ();
+      double* target = result.data ();
 
       // First point.
       //
-      s = derivative (x.value (0), this->value (0),
-                      x.value (1), this->value (1));
-      result.append (s);
+      target [0] = derivative (xData [0], yData [0], xData [1], yData [1]);
 
       // Middle points.
       //
-      for (j = 1 ; j < size - 1; j++) {
-         s = derivative (x.value(j - 1), this->value(j - 1),
-                         x.value(j    ), this->value(j    ),
-                         x.value(j + 1), this->value(j + 1));
-         result.append (s);
+      const int last = size - 2;
+      int next = 1;
+
+#ifdef QE_SIMD_X86
+      switch (QEPlatform::simdLevel ()) {
+         case QEPlatform::simdAvx2:
+            next = avx2DyByDx (xData, yData, last, target);
+            break;
+         case QEPlatform::simdSse2:
+            next = sse2DyByDx (xData, yData, last, target);
+            break;
+         default:
+            break;
       }
+#endif
+
+      scalarDyByDx (xData, yData, next, last, target);
 
       // Last point.
       //
-      s = derivative (x.value (size - 2), this->value (size - 2),
-                      x.value (size - 1), this->value (size - 1));
-      result.append (s);
+      target [size - 1] = derivative (xData [size - 2], yData [size - 2],
+                                      xData [size - 1], yData [size - 1]);
    }
 
    return result;
 }
 
+//---------------------------------------------------------------------------------
+// Median filter support functions.
+//---------------------------------------------------------------------------------
+//
+// Orders NaN values after all other values, so that we have a strict weak
+// ordering as required by std::sort and std::nth_element.
+//
+static bool medianLessThan (const double a, const double b)
+{
+   return (a < b) || (!QEPlatform::isNaN (a) && QEPlatform::isNaN (b));
+}
+
+//---------------------------------------------------------------------------------
+// Compare and swap using the same NaN last ordering as the general case. Note:
+// std::min/std::max are not used as, given a NaN, both may return the NaN, so
+// a single NaN could be duplicated across the window.
+//
+#define SORT2(a,b) {                   \
+   if (medianLessThan (b, a)) {        \
+      const double t = a;              \
+      a = b;                           \
+      b = t;                           \
+   }                                   \
+}
+
+// Median sorting networks, after N. Devillard, "Fast median search".
+//
+static double median3 (const double* p)
+{
+   double p0 = p[0], p1 = p[1], p2 = p[2];
+   SORT2 (p0, p1); SORT2 (p1, p2); SORT2 (p0, p1);
+   return p1;
+}
+
+static double median5 (const double* p)
+{
+   double p0 = p[0], p1 = p[1], p2 = p[2], p3 = p[3], p4 = p[4];
+   SORT2 (p0, p1); SORT2 (p3, p4); SORT2 (p0, p3);
+   SORT2 (p1, p4); SORT2 (p1, p2); SORT2 (p2, p3);
+   SORT2 (p1, p2);
+   return p2;
+}
+
+static double median7 (const double* p)
+{
+   double p0 = p[0], p1 = p[1], p2 = p[2], p3 = p[3], p4 = p[4], p5 = p[5], p6 = p[6];
+   SORT2 (p0, p5); SORT2 (p0, p3); SORT2 (p1, p6);
+   SORT2 (p2, p4); SORT2 (p0, p1); SORT2 (p3, p5);
+   SORT2 (p2, p6); SORT2 (p2, p3); SORT2 (p3, p6);
+   SORT2 (p4, p5); SORT2 (p1, p4); SORT2 (p1, p3);
+   SORT2 (p3, p4);
+   return p3;
+}
+
+#undef SORT2
+
+//---------------------------------------------------------------------------------
+// Median of the slice [pos, end], as per a full sort - used for the edges.
+// The work vector is re-used to avoid an allocation per element.
+//
+static double sliceMedian (const double* data, const int pos, const int end,
+                           std::vector<double>& work)
+{
+   work.assign (data + pos, data + end + 1);
+   const int k = int (work.size ()) / 2;
+   std::nth_element (work.begin (), work.begin () + k, work.end (), medianLessThan);
+   return work [k];
+}
+
+//---------------------------------------------------------------------------------
+// Orders element indices by element value.
+//
+struct IndexLessThan {
+   explicit IndexLessThan (const double* dataIn) : data (dataIn) {}
+   bool operator () (const int a, const int b) const {
+      return medianLessThan (this->data [a], this->data [b]);
+   }
+   const double* data;
+};
+
 //---------------------------------------------------------------------------------
 //
 QEFloatingArray QEFloatingArray::medianFilter (const int window)
 {
    const int size = this->size ();
    QEFloatingArray result;
-   result.reserve (size);
 
-   if (window > 1) {
-      const int offset = window / 2;
+   if ((window <= 1) || (size <= 0)) {
+      // Window size is 1 (identity) or invalid - just return this vector.
+      //
+      result = *this;
+      return result;
+   }
+
+   // Note: the effective window length is always odd. At the edges, the
+   // window is truncated and the median is the upper median.
+   //
+   const int offset = window / 2;
+   const int length = 2 * offset + 1;
+   const double* data = this->constData ();
+   std::vector<double> work;
+
+   result.resize (size);
+   double* target = result.data ();
+
+   if (length <= 7) {
+      // Small window specialisation - sorting networks.
+      //
       for (int j = 0; j < size; j++) {
-         // Must cater for edge effects
-         //
-         int pos = MAX (j - offset, 0);
-         int end = MIN (j + offset, size - 1);
-
-         // Extract vector slice, sort and extract middle, i.e. median, value.
-         //
-         QVector<double> qtemp = this->mid (pos, end - pos + 1);
-         std::vector <double> temp;
-
-         // Create a std vector form the QVector. Is there a better way?
-         //
-         for (int j = 0; j < qtemp.size(); j++) {
-            temp.push_back(qtemp[j]);
+         if ((j < offset) || (j + offset >= size)) {
+            // Must cater for edge effects
+            //
+            target [j] = sliceMedian (data, MAX (j - offset, 0), MIN (j + offset, size - 1), work);
+            continue;
          }
 
-         std::sort (temp.begin(), temp.end());
-         result.append (temp [qtemp.size ()/2]);
+         const double* p = data + j - offset;
+         switch (length) {
+            case 3:  target [j] = median3 (p); break;
+            case 5:  target [j] = median5 (p); break;
+            default: target [j] = median7 (p); break;
+         }
       }
-   } else {
-      // Window size is 1 (identity) or invalid - just return this vector.
+      return result;
+   }
+
+   // General case - sliding window order statistics, O(n log n) overall.
+   // Each element is given a unique rank (its position in sorted order), and
+   // the window is held as a Fenwick (binary indexed) tree of ranks, which
+   // allows insert, remove and find k-th smallest each in O(log n).
+   //
+   std::vector<int> order (size);
+   for (int j = 0; j < size; j++) order [j] = j;
+   std::sort (order.begin (), order.end (), IndexLessThan (data));
+
+   std::vector<int> rank (size);
+   for (int r = 0; r < size; r++) rank [order [r]] = r;
+
+   std::vector<int> tree (size + 1, 0);
+   int topBit = 1;
+   while (topBit * 2 <= size) topBit *= 2;
+
+   // Insert the initial window, less the last element.
+   //
+   for (int i = 0; i < MIN (offset, size); i++) {
+      for (int x = rank [i] + 1; x <= size; x += x & (-x)) tree [x]++;
+   }
+
+   for (int j = 0; j < size; j++) {
+      // Slide the window - add the incoming element and remove the outgoing element.
       //
-      result = *this;
+      const int incoming = j + offset;
+      if (incoming < size) {
+         for (int x = rank [incoming] + 1; x <= size; x += x & (-x)) tree [x]++;
+      }
+
+      const int outgoing = j - offset - 1;
+      if (outgoing >= 0) {
+         for (int x = rank [outgoing] + 1; x <= size; x += x & (-x)) tree [x]--;
+      }
+
+      // Find the (k+1)-th smallest rank, where k = window number / 2.
+      //
+      const int pos = MAX (j - offset, 0);
+      const int end = MIN (j + offset, size - 1);
+      int k = (end - pos + 1) / 2 + 1;
+      int r = 0;
+      for (int bit = topBit; bit > 0; bit >>= 1) {
+         if ((r + bit <= size) && (tree [r + bit] < k)) {
+            r += bit;
+            k -= tree [r];
+         }
+      }
+
+      target [j] = data [order [r]];   // r is the 0-based rank
    }
+
    return result;
 }
 
-
-#define MIN_DELTA_X  (1.0E-20)
-
 //---------------------------------------------------------------------------------
 // static
 double QEFloatingArray::derivative (const double xp1, const double yp1,
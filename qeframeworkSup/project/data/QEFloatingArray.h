@@ -53,6 +53,25 @@ public:
    double minimumValue (const double& defaultValue = 0.0, const bool includeInf = false);
    double maximumValue (const double& defaultValue = 0.0, const bool includeInf = false);
 
+   // Single pass summary of the array, using the same NaN/inf rules as above.
+   // The minimum and maximum are only meaningful when count > 0.
+   // Where available, this uses SIMD (SSE2/AVX2) kernels selected at run time.
+   //
+   struct Summary {
+      double minimum;
+      double maximum;
+      double sum;
+      int count;          // number of usable elements, i.e. included in min/max/sum
+      int nanCount;       // number of NaN elements
+   };
+
+   Summary summary (const bool includeInf = false) const;
+
+   // Find both min and max values in a single pass. If array has zero usable
+   // elements then min and max are not modified and false is returned.
+   //
+   bool minMaxValues (double& min, double& max, const bool includeInf = false) const;
+
    // Calculates dThis/dx for each point using a series of three-point
    // polynomials. First an last point based to a two-point polynomial.
    //
@@ -105,15 +105,43 @@ void QEInteger::writeInteger( const QVector<long> &data )
 void QEInteger::convertVariant( const QVariant &value, QCaAlarmInfo& alarmInfo,
                                 QCaDateTime& timeStamp, const unsigned int& variableIndex )
 {
-   if( ( value.type() == QVariant::List ) || QEVectorVariants::isVectorVariant( value ) )
+   // Only form the array and emit the array signal if at least one receiver.
+   // Forming the array is O(n), which is wasted when only the element at the
+   // array index is used, e.g. by a single element widget on a large waveform.
+   //
+   static const char* arraySignal =
+         SIGNAL( integerArrayChanged( const QVector<long>&, QCaAlarmInfo&, QCaDateTime&, const unsigned int& ) );
+   const bool arrayRequired = ( this->receivers( arraySignal ) > 0 );
+
+   const int ai = getArrayIndex();
+
+   if( QEVectorVariants::isVectorVariant( value ) )
+   {
+      // Vector variants, e.g. as delivered for CA and PVA numeric arrays,
+      // provide typed element access - no intermediate QVariantList.
+      //
+      if( arrayRequired ) {
+         emit integerArrayChanged( integerFormat->formatIntegerArray( value ),
+                                   alarmInfo, timeStamp, variableIndex );
+      }
+
+      if( ai >= 0 && ai < QEVectorVariants::vectorCount( value ) ) {
+         // Convert this array element as a scalar update.
+         const long item = integerFormat->formatInteger( value, ai );
+         emit integerChanged( item, alarmInfo, timeStamp, variableIndex );
+      }
+   }
+   else if( value.type() == QVariant::List )
    {
-      emit integerArrayChanged( integerFormat->formatIntegerArray( value ),
-                                alarmInfo, timeStamp, variableIndex );
+      if( arrayRequired ) {
+         emit integerArrayChanged( integerFormat->formatIntegerArray( value ),
+                                   alarmInfo, timeStamp, variableIndex );
+      }
 
-      int ai = getArrayIndex();
-      if( ai >= 0 && ai < value.toList().count() ) {
+      const QVariantList list = value.toList();
+      if( ai >= 0 && ai < list.count() ) {
          // Convert this array element as a scalar update.
-         const long item = integerFormat->formatInteger( value.toList().value( ai ));
+         const long item = integerFormat->formatInteger( list.value( ai ) );
          emit integerChanged( item, alarmInfo, timeStamp, variableIndex );
       }
    }
@@ -124,10 +152,12 @@ void QEInteger::convertVariant( const QVariant &value, QCaAlarmInfo& alarmInfo,
 
       // A scalar is also an array with one element.
       //
-      QVariantList array;
-      array.append (value);
-      emit integerArrayChanged( integerFormat->formatIntegerArray( array ),
-                                alarmInfo, timeStamp, variableIndex );
+      if( arrayRequired ) {
+         QVariantList array;
+         array.append (value);
+         emit integerArrayChanged( integerFormat->formatIntegerArray( array ),
+                                   alarmInfo, timeStamp, variableIndex );
+      }
    }
 }
 
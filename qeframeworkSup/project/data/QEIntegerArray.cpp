@@ -25,6 +25,102 @@
 
 #include <QECommon.h>
 #include <QEIntegerArray.h>
+#include <QEPlatform.h>
+
+#ifdef QE_SIMD_X86
+#include <immintrin.h>
+#endif
+
+//=================================================================================
+// Min/max kernels. These process the bulk of the array and return the number of
+// elements processed, the remainder being processed by the scalar loop.
+// The min and max arguments must be initialised by the caller.
+//=================================================================================
+//
+#ifdef QE_SIMD_X86
+
+QE_TARGET_SSE2
+static int sse2MinMax (const qint32* data, const int number, qint32& min, qint32& max)
+{
+   const int processed = number & ~3;
+   if (processed == 0) return 0;
+
+   // SSE2 has no 32 bit min/max - select using compare results.
+   //
+   __m128i vmin = _mm_set1_epi32 (min);
+   __m128i vmax = _mm_set1_epi32 (max);
+   for (int j = 0; j < processed; j += 4) {
+      const __m128i v = _mm_loadu_si128 ((const __m128i*) (data + j));
+      const __m128i lt = _mm_cmplt_epi32 (v, vmin);
+      const __m128i gt = _mm_cmpgt_epi32 (v, vmax);
+      vmin = _mm_or_si128 (_mm_and_si128 (lt, v), _mm_andnot_si128 (lt, vmin));
+      vmax = _mm_or_si128 (_mm_and_si128 (gt, v), _mm_andnot_si128 (gt, vmax));
+   }
+
+   qint32 mins [4], maxs [4];
+   _mm_storeu_si128 ((__m128i*) mins, vmin);
+   _mm_storeu_si128 ((__m128i*) maxs, vmax);
+   for (int k = 0; k < 4; k++) {
+      min = MIN (min, mins [k]);
+      max = MAX (max, maxs [k]);
+   }
+   return processed;
+}
+
+//---------------------------------------------------------------------------------
+//
+QE_TARGET_AVX2
+static int avx2MinMax (const qint32* data, const int number, qint32& min, qint32& max)
+{
+   const int processed = number & ~7;
+   if (processed == 0) return 0;
+
+   __m256i vmin = _mm256_set1_epi32 (min);
+   __m256i vmax = _mm256_set1_epi32 (max);
+   for (int j = 0; j < processed; j += 8) {
+      const __m256i v = _mm256_loadu_si256 ((const __m256i*) (data + j));
+      vmin = _mm256_min_epi32 (vmin, v);
+      vmax = _mm256_max_epi32 (vmax, v);
+   }
+
+   qint32 mins [8], maxs [8];
+   _mm256_storeu_si256 ((__m256i*) mins, vmin);
+   _mm256_storeu_si256 ((__m256i*) maxs, vmax);
+   for (int k = 0; k < 8; k++) {
+      min = MIN (min, mins [k]);
+      max = MAX (max, maxs [k]);
+   }
+   return processed;
+}
+
+//---------------------------------------------------------------------------------
+// AVX2 has no 64 bit min/max - select using compare results.
+//
+QE_TARGET_AVX2
+static int avx2MinMax (const qint64* data, const int number, qint64& min, qint64& max)
+{
+   const int processed = number & ~3;
+   if (processed == 0) return 0;
+
+   __m256i vmin = _mm256_set1_epi64x (min);
+   __m256i vmax = _mm256_set1_epi64x (max);
+   for (int j = 0; j < processed; j += 4) {
+      const __m256i v = _mm256_loadu_si256 ((const __m256i*) (data + j));
+      vmin = _mm256_blendv_epi8 (vmin, v, _mm256_cmpgt_epi64 (vmin, v));
+      vmax = _mm256_blendv_epi8 (vmax, v, _mm256_cmpgt_epi64 (v, vmax));
+   }
+
+   qint64 mins [4], maxs [4];
+   _mm256_storeu_si256 ((__m256i*) mins, vmin);
+   _mm256_storeu_si256 ((__m256i*) maxs, vmax);
+   for (int k = 0; k < 4; k++) {
+      min = MIN (min, mins [k]);
+      max = MAX (max, maxs [k]);
+   }
+   return processed;
+}
+
+#endif  // QE_SIMD_X86
 
 //=================================================================================
 // QEIntegerArray
@@ -53,32 +149,70 @@ QEIntegerArray& QEIntegerArray::operator=( const  QVector<long>& other )
 
 //---------------------------------------------------------------------------------
 //
-long QEIntegerArray::minimumValue (const long& defaultValue)
+bool QEIntegerArray::minMaxValues (long& min, long& max) const
 {
-   int n = this->count ();
-   long r;
+   const long* data = this->constData ();
+   const int n = this->count ();
+
+   if (n == 0) return false;
+
+   long rmin = data [0];
+   long rmax = data [0];
+   int processed = 0;
 
-   if (n == 0) return defaultValue;
-   r = this->value (0);
-   for (int j = 1; j < n; j++) {
-      r = MIN (r, this->value (j));
+#ifdef QE_SIMD_X86
+   // long is 64 bit on LP64 systems and 32 bit on LLP64 (Windows) systems.
+   //
+   const QEPlatform::SimdLevels level = QEPlatform::simdLevel ();
+   if (sizeof (long) == sizeof (qint64)) {
+      qint64 kmin = rmin;
+      qint64 kmax = rmax;
+      if (level >= QEPlatform::simdAvx2) {
+         processed = avx2MinMax ((const qint64*) data, n, kmin, kmax);
+      }
+      rmin = long (kmin);
+      rmax = long (kmax);
+   } else {
+      qint32 kmin = qint32 (rmin);
+      qint32 kmax = qint32 (rmax);
+      if (level >= QEPlatform::simdAvx2) {
+         processed = avx2MinMax ((const qint32*) data, n, kmin, kmax);
+      } else if (level >= QEPlatform::simdSse2) {
+         processed = sse2MinMax ((const qint32*) data, n, kmin, kmax);
+      }
+      rmin = long (kmin);
+      rmax = long (kmax);
    }
-   return r;
+#endif
+
+   for (int j = processed; j < n; j++) {
+      rmin = MIN (rmin, data [j]);
+      rmax = MAX (rmax, data [j]);
+   }
+
+   min = rmin;
+   max = rmax;
+   return true;
 }
 
 //---------------------------------------------------------------------------------
 //
-long QEIntegerArray::maximumValue (const long& defaultValue)
+long QEIntegerArray::minimumValue (const long& defaultValue)
 {
-   int n = this->count ();
-   long r;
+   long min = defaultValue;
+   long max;
+   this->minMaxValues (min, max);
+   return min;
+}
 
-   if (n == 0) return defaultValue;
-   r = this->value (0);
-   for (int j = 1; j < n; j++) {
-      r = MAX (r, this->value (j));
-   }
-   return r;
+//---------------------------------------------------------------------------------
+//
+long QEIntegerArray::maximumValue (const long& defaultValue)
+{
+   long min;
+   long max = defaultValue;
+   this->minMaxValues (min, max);
+   return max;
 }
 
 // end
@@ -50,6 +50,12 @@ public:
    //
    long minimumValue (const long& defaultValue = 0);
    long maximumValue (const long& defaultValue = 0);
+
+   // Find both min and max values in a single pass. If array has zero elements
+   // then min and max are not modified and false is returned.
+   // Where available, this uses SIMD (SSE2/AVX2) kernels selected at run time.
+   //
+   bool minMaxValues (long& min, long& max) const;
 };
 
 #endif   // QEINTEGER_ARRAY_H
@@ -170,6 +170,14 @@ void QEString::convertVariant( const QVariant& value, QCaAlarmInfo& alarmInfo,
     emit stringChanged( formatted, alarmInfo, timeStamp, variableIndex );
 }
 
+/*
+    The resolution of the formatted string, i.e. half of the least significant
+    displayed digit. QCaObject drops updates that round to the same displayed digit.
+*/
+double QEString::getAutoDeadbandValue() const {
+    return stringFormat ? stringFormat->getResolution() : 0.0;
+}
+
 /*
     Re send connection change and with variableIndex - depricated.
 */
@@ -54,6 +54,9 @@ class QE_FRAMEWORK_LIBRARY_SHARED_EXPORT QEString : public qcaobject::QCaObject
     void writeStringElement( const QString& data );
     void writeString( const QVector<QString>& data );
 
+  protected:
+    double getAutoDeadbandValue() const;
+
   private:
     void initialise( QEStringFormatting* newStringFormat );
     QEStringFormatting *stringFormat;
@@ -26,6 +26,7 @@
 
 #include "QEStringFormatting.h"
 #include <stdio.h>
+#include <string.h>
 #include <math.h>
 #include <limits>
 #include <QDebug>
@@ -72,6 +73,8 @@ QEStringFormatting::QEStringFormatting ()
    this->dbPrecision = 0;
    this->dbEnumerations.clear();
    this->dbFormatArray = false;
+
+   this->compiled.valid = false;
 }
 
 //------------------------------------------------------------------------------
@@ -86,6 +89,7 @@ QEStringFormatting::~QEStringFormatting () {}    // place holder
 void QEStringFormatting::setDbPrecision (const unsigned int dbPrecisionIn)
 {
    this->dbPrecision = dbPrecisionIn;
+   this->compiled.valid = false;
 }
 
 //------------------------------------------------------------------------------
@@ -95,6 +99,7 @@ void QEStringFormatting::setDbPrecision (const unsigned int dbPrecisionIn)
 void QEStringFormatting::setDbEgu (const QString eguIn)
 {
    this->dbEgu = eguIn;
+   this->compiled.valid = false;
 }
 
 //----------------------------------------------------------------------------
@@ -384,21 +389,29 @@ void QEStringFormatting::determineDbFormat (const QVariant& value) const
       }
    }
 
-   // Determine the formatting type from the variant type
+   // Determine the formatting type from the variant type.
+   // Note: float, char and short types are only defined as QMetaType types,
+   // e.g. elements of a CA FLOAT, CHAR or ENUM waveform.
    //
-   switch (t) {
+   switch (int (t)) {
       case QVariant::Double:
+      case QMetaType::Float:
          this->dbFormat = QE::Floating;
          break;
 
       case QVariant::LongLong:
       case QVariant::Int:
+      case QMetaType::Short:
+      case QMetaType::Char:
+      case QMetaType::SChar:
          // Could be an ENUM
          this->dbFormat = QE::Integer;
          break;
 
       case QVariant::ULongLong:
       case QVariant::UInt:
+      case QMetaType::UShort:
+      case QMetaType::UChar:
          this->dbFormat = QE::UnsignedInteger;
          break;
 
@@ -437,6 +450,8 @@ QString QEStringFormatting::formatString (const QVariant& value, int arrayIndex)
    QString result;
    bool isNumeric = false;
 
+   if (!this->compiled.valid) this->compileFormat ();
+
    const int valueType = value.type ();
    if ((valueType != QVariant::List) &&
        (valueType != QVariant::StringList) &&
@@ -444,6 +459,30 @@ QString QEStringFormatting::formatString (const QVariant& value, int arrayIndex)
       // "Simple" scalar
       result = this->formatElementString (value, isNumeric);
 
+   } else if (QEVectorVariants::isVectorVariant (value) &&
+              (this->arrayAction == QE::Index)) {
+      // Vector variant, single element - use typed element access, i.e.
+      // avoid converting the whole vector to a QVariantList.
+      //
+      const int number = QEVectorVariants::vectorCount (value);
+      if ((arrayIndex >= 0) && (arrayIndex < number)) {
+         const QVariant element = QEVectorVariants::getVariantValue (value, arrayIndex, QVariant ());
+         result = this->formatElementString (element, isNumeric);
+      }
+
+   } else if (QEVectorVariants::isVectorVariant (value) &&
+              (this->arrayAction == QE::Ascii)) {
+      // Vector variant as a string - use the typed elements directly.
+      //
+      this->asciiVectorImage (value, result);
+
+   } else if (QEVectorVariants::isVectorVariant (value) &&
+              (this->arrayAction == QE::Append) &&
+              this->appendVectorImages (value, result)) {
+      // Vector variant numeric values - formatted directly from the typed elements.
+      //
+      isNumeric = true;
+
    } else {
       // Array variable / or vector variant.
       //
@@ -481,6 +520,7 @@ QString QEStringFormatting::formatString (const QVariant& value, int arrayIndex)
             // Interpret each element in the array as an unsigned integer and append
             // string representations of each element from the array with a space in
             // between each.
+            result.reserve (8 * number);
             for (int j = 0; j < number; j++) {
                QVariant element = valueArray.value (j);
                QString elementString;
@@ -536,12 +576,11 @@ QString QEStringFormatting::formatString (const QVariant& value, int arrayIndex)
       }
    }
 
-   // Add units if required, if there are any present, and if the text is not an error message
-   // ??? Why cant this be in the 'if' statement?  If it is it never adds an egu
+   // Add units if required, if there are any present, and if the text is not an error message.
+   // The suffix is pre-computed by compileFormat.
    //
-   int eguLen = dbEgu.length ();
-   if (isNumeric && this->addUnits && (eguLen > 0) && (this->format != QE::Time)) {
-      result.append (" ").append (dbEgu);
+   if (isNumeric && !this->compiled.unitsSuffix.isEmpty ()) {
+      result.append (this->compiled.unitsSuffix);
    }
 
    return result;
@@ -687,6 +726,230 @@ QString QEStringFormatting::formatElementString (const QVariant& value,
    return result;
 }
 
+//------------------------------------------------------------------------------
+// Appends the images of each element separated by a space into the image buffer.
+// The element format is determined once for the whole vector.
+//
+template<typename Element>
+void QEStringFormatting::appendElementImages (const QVector<Element>& data,
+                                              const QE::Formats elementFormat) const
+{
+   const int number = data.count ();
+   const Element* elements = data.constData ();
+   char image[ImageSize];
+
+   switch (elementFormat) {
+      case QE::Floating:
+         for (int j = 0; j < number; j++) {
+            const int length = this->floatingImage (image, double (elements[j]));
+            if (j > 0) this->imageBuffer.append (' ');
+            this->imageBuffer.append (image, length);
+         }
+         break;
+
+      case QE::Integer:
+         for (int j = 0; j < number; j++) {
+            const int length = this->integerImage <long> (image, long (elements[j]));
+            if (j > 0) this->imageBuffer.append (' ');
+            this->imageBuffer.append (image, length);
+         }
+         break;
+
+      case QE::UnsignedInteger:
+         for (int j = 0; j < number; j++) {
+            const int length = this->integerImage <unsigned long> (image, (unsigned long) (elements[j]));
+            if (j > 0) this->imageBuffer.append (' ');
+            this->imageBuffer.append (image, length);
+         }
+         break;
+
+      default:
+         break;
+   }
+}
+
+//------------------------------------------------------------------------------
+// Array action is QE::Append and the value is a vector variant.
+// Formats directly from the typed vector elements, i.e. no QVariantList and no
+// per element QVariant/QString temporaries.
+//
+bool QEStringFormatting::appendVectorImages (const QVariant& value, QString& result) const
+{
+   const QEVectorVariants::OwnTypes ownType = QEVectorVariants::getOwnType (value);
+
+   // Determine the format from the element type, as determineDbFormat would
+   // for each element when converted to a QVariantList.
+   //
+   QE::Formats typeFormat;
+   switch (ownType) {
+      case QEVectorVariants::DoubleVector:
+      case QEVectorVariants::FloatVector:
+         typeFormat = QE::Floating;
+         break;
+
+      case QEVectorVariants::Int8Vector:
+      case QEVectorVariants::Int16Vector:
+      case QEVectorVariants::Int32Vector:
+      case QEVectorVariants::Int64Vector:
+         typeFormat = QE::Integer;
+         break;
+
+      case QEVectorVariants::Uint8Vector:
+      case QEVectorVariants::Uint16Vector:
+      case QEVectorVariants::Uint32Vector:
+      case QEVectorVariants::Uint64Vector:
+         typeFormat = QE::UnsignedInteger;
+         break;
+
+      default:
+         // Bool elements are not recognised by determineDbFormat.
+         typeFormat = QE::Default;
+         break;
+   }
+
+   QE::Formats elementFormat = this->format;
+   if (elementFormat == QE::Default) {
+      // Enumerations are left to the general case.
+      if (this->dbEnumerations.size () > 0) return false;
+      elementFormat = typeFormat;
+   }
+
+   if ((elementFormat != QE::Floating) &&
+       (elementFormat != QE::Integer) &&
+       (elementFormat != QE::UnsignedInteger)) return false;
+
+   // Floating point values formatted as integers are rounded by QVariant,
+   // leave these to the general case.
+   //
+   if (((ownType == QEVectorVariants::DoubleVector) ||
+        (ownType == QEVectorVariants::FloatVector)) &&
+       (elementFormat != QE::Floating)) return false;
+
+   const int number = QEVectorVariants::vectorCount (value);
+
+   this->imageBuffer.resize (0);
+   this->imageBuffer.reserve (8 * number);
+
+   switch (ownType) {
+      case QEVectorVariants::DoubleVector:
+         this->appendElementImages (value.value<QEDoubleVector> (), elementFormat);
+         break;
+
+      case QEVectorVariants::FloatVector:
+         this->appendElementImages (value.value<QEFloatVector> (), elementFormat);
+         break;
+
+      case QEVectorVariants::BoolVector:
+         this->appendElementImages (value.value<QEBoolVector> (), elementFormat);
+         break;
+
+      case QEVectorVariants::Int8Vector:
+         this->appendElementImages (value.value<QEInt8Vector> (), elementFormat);
+         break;
+
+      case QEVectorVariants::Int16Vector:
+         this->appendElementImages (value.value<QEInt16Vector> (), elementFormat);
+         break;
+
+      case QEVectorVariants::Int32Vector:
+         this->appendElementImages (value.value<QEInt32Vector> (), elementFormat);
+         break;
+
+      case QEVectorVariants::Int64Vector:
+         this->appendElementImages (value.value<QEInt64Vector> (), elementFormat);
+         break;
+
+      case QEVectorVariants::Uint8Vector:
+         this->appendElementImages (value.value<QEUint8Vector> (), elementFormat);
+         break;
+
+      case QEVectorVariants::Uint16Vector:
+         this->appendElementImages (value.value<QEUint16Vector> (), elementFormat);
+         break;
+
+      case QEVectorVariants::Uint32Vector:
+         this->appendElementImages (value.value<QEUint32Vector> (), elementFormat);
+         break;
+
+      case QEVectorVariants::Uint64Vector:
+         this->appendElementImages (value.value<QEUint64Vector> (), elementFormat);
+         break;
+
+      default:
+         return false;
+   }
+
+   // Mimic formatElementString/determineDbFormat as used by the general case,
+   // as dbFormat is subsequently used by formatValue.
+   //
+   if (number > 0) {
+      this->dbFormat = typeFormat;
+      this->dbFormatArray = false;
+   }
+
+   result = QString::fromLatin1 (this->imageBuffer.constData (), this->imageBuffer.size ());
+   return true;
+}
+
+//------------------------------------------------------------------------------
+// Interpret each element from the array as a character in a string.
+// Translate all non printing characters to '?' except for trailing zeros
+// (ignore them).
+//
+template<typename Element>
+static void appendAsciiImage (QByteArray& buffer, const QVector<Element>& codes)
+{
+   const int number = codes.count ();
+   const Element* elements = codes.constData ();
+
+   for (int j = 0; j < number; j++) {
+      const int c = int (elements[j]);
+      if (c == 0) break;    // got a zero - end of string.
+
+      if (c == '\r') {
+         // Ignore carriage returns.
+      } else if ((c != '\n') && (c < ' ' || c > '~')) {
+         buffer.append ('?');
+      } else {
+         buffer.append (char (c));
+      }
+   }
+}
+
+//------------------------------------------------------------------------------
+// Array action is QE::Ascii and the value is a vector variant.
+// Char waveforms are processed directly, otherwise via a typed integer vector.
+//
+void QEStringFormatting::asciiVectorImage (const QVariant& value, QString& result) const
+{
+   this->imageBuffer.resize (0);
+   this->imageBuffer.reserve (QEVectorVariants::vectorCount (value));
+
+   switch (QEVectorVariants::getOwnType (value)) {
+      case QEVectorVariants::Int8Vector:
+         appendAsciiImage (this->imageBuffer, value.value<QEInt8Vector> ());
+         break;
+
+      case QEVectorVariants::Uint8Vector:
+         appendAsciiImage (this->imageBuffer, value.value<QEUint8Vector> ());
+         break;
+
+      default:
+         {
+            bool okay = false;
+            const QVector<long> codes = QEVectorVariants::convertToIntegerVector (value, okay);
+            if (!okay) {
+               result = this->formatFailure (QString ("Conversion to integer vector failed"));
+               return;
+            }
+            appendAsciiImage (this->imageBuffer, codes);
+         }
+         break;
+   }
+
+   result = QString::fromLatin1 (this->imageBuffer.constData (), this->imageBuffer.size ());
+}
+
 //------------------------------------------------------------------------------
 // Format a variant value as a string representation of time.
 // This is always in decimal, the format is: [days] HH:MM:SS[.FRACTION]
@@ -746,6 +1009,7 @@ void QEStringFormatting::setPrecision (const int precisionIn)
    // Ensure range is sensible.
    //
    this->precision = LIMIT (precisionIn, 0, 64);
+   this->compiled.valid = false;
 }
 
 //------------------------------------------------------------------------------
@@ -758,6 +1022,7 @@ void QEStringFormatting::setPrecision (const int precisionIn)
 void QEStringFormatting::setUseDbPrecision (const bool useDbPrecisionIn)
 {
    this->useDbPrecision = useDbPrecisionIn;
+   this->compiled.valid = false;
 }
 
 //------------------------------------------------------------------------------
@@ -775,6 +1040,7 @@ void QEStringFormatting::setLeadingZero (const bool leadingZeroIn)
 void QEStringFormatting::setLeadingZeros (const int leadingZerosIn)
 {
    this->leadingZeros = LIMIT (leadingZerosIn, 0, 64);
+   this->compiled.valid = false;
 }
 
 //------------------------------------------------------------------------------
@@ -793,6 +1059,7 @@ void QEStringFormatting::setTrailingZeros (const bool trailingZerosIn)
 void QEStringFormatting::setForceSign (const bool forceSignIn)
 {
    this->forceSign = forceSignIn;
+   this->compiled.valid = false;
 }
 
 //------------------------------------------------------------------------------
@@ -802,6 +1069,7 @@ void QEStringFormatting::setForceSign (const bool forceSignIn)
 void QEStringFormatting::setFormat (const QE::Formats formatIn)
 {
    this->format = formatIn;
+   this->compiled.valid = false;
 }
 
 //------------------------------------------------------------------------------
@@ -810,6 +1078,7 @@ void QEStringFormatting::setFormat (const QE::Formats formatIn)
 void QEStringFormatting::setSeparator (const QE::Separators separatorIn)
 {
    this->separator = separatorIn;
+   this->compiled.valid = false;
 }
 
 //------------------------------------------------------------------------------
@@ -824,6 +1093,7 @@ void QEStringFormatting::setSeparator (const QE::Separators separatorIn)
 void QEStringFormatting::setRadix (const int radix)
 {
    this->radixBase = LIMIT (radix, 2, 16);
+   this->compiled.valid = false;
 }
 
 //------------------------------------------------------------------------------
@@ -833,6 +1103,7 @@ void QEStringFormatting::setRadix (const int radix)
 void QEStringFormatting::setUseRadixPrefix (const bool useRadixPrefixIn)
 {
    this->useRadixPrefix = useRadixPrefixIn;
+   this->compiled.valid = false;
 }
 
 //------------------------------------------------------------------------------
@@ -858,6 +1129,7 @@ void QEStringFormatting::setArrayAction (const QE::ArrayActions arrayActionIn)
 void QEStringFormatting::setAddUnits (const bool AddUnitsIn)
 {
    this->addUnits = AddUnitsIn;
+   this->compiled.valid = false;
 }
 
 //------------------------------------------------------------------------------
@@ -999,12 +1271,46 @@ int QEStringFormatting::getLeadingZeros () const
    return this->leadingZeros;
 }
 
+//------------------------------------------------------------------------------
+//
+double QEStringFormatting::getResolution () const
+{
+   double result = 0.0;
+
+   switch (this->format) {
+      case QE::Default:
+      case QE::Floating:
+         if (this->notation == QE::Fixed) {
+            const int prec = LIMIT (this->useDbPrecision ? this->dbPrecision : this->precision, 0, 64);
+            result = 0.5 * pow (double (this->radixBase), -prec);
+         }
+         break;
+
+      case QE::Integer:
+      case QE::UnsignedInteger:
+         result = 0.5;
+         break;
+
+      default:
+         // Time, local enumerations and strings - any change may be visible.
+         result = 0.0;
+         break;
+   }
+
+   return result;
+}
+
 //==============================================================================
 // General purpose value to/from string in any radix
 //==============================================================================
 //
 static const char radixChars[] = "0123456789ABCDEF";
 
+// Largest integer such that all smaller integers are exactly representable
+// as a double, i.e. 2^53.
+//
+#define MAX_EXACT_INTEGER   Q_UINT64_C (9007199254740992)
+
 // Must be consistant with enum Separators specification.
 //
 const static char separatorChars[] = "?,_ ";
@@ -1017,6 +1323,61 @@ static const int separatorGaps[17] = {
    5, /* 10 => */ 3, 5, 5, 5, 5, 5, /* 16 => */ 4
 };
 
+//------------------------------------------------------------------------------
+// Pre-compute the numeric formatting options. These depend only on the
+// formatting configuration and the database precision/egu.
+//
+void QEStringFormatting::compileFormat () const
+{
+   NumericFormat& cf = this->compiled;    // alias
+
+   cf.precision = LIMIT (this->useDbPrecision ? int (this->dbPrecision) : this->precision, 0, 64);
+   cf.zeros = LIMIT (this->leadingZeros, 0, 64);
+   cf.sepChar = separatorChars[this->separator];
+   cf.gap = (this->separator == QE::NoSeparator) ? -1 : separatorGaps[this->radixBase];
+   cf.signChar = this->forceSign ? '+' : '\0';
+
+   // Is a radix prefix required?
+   //
+   if (this->useRadixPrefix && (this->radixBase != 10)) {
+      if (this->radixBase == 16) {
+         snprintf (cf.prefix, sizeof (cf.prefix), "0x");
+      } else {
+         snprintf (cf.prefix, sizeof (cf.prefix), "%d#", this->radixBase);
+      }
+   } else {
+      cf.prefix[0] = '\0';
+   }
+   cf.prefixLength = int (strlen (cf.prefix));
+
+   const double dblRadix = this->radixBase;
+   cf.roundUp = pow ((1.0 / dblRadix), cf.precision) * 0.5;
+   cf.fixedScale = pow (dblRadix, cf.precision);
+
+   // The integer fixed point path requires radix ^ precision to be exact.
+   //
+   cf.fixedDivisor = 1;
+   for (int j = 0; j < cf.precision; j++) {
+      cf.fixedDivisor *= quint64 (this->radixBase);
+      if (cf.fixedDivisor > MAX_EXACT_INTEGER) {
+         cf.fixedDivisor = 0;   // too big - use general fixed point algorithm
+         break;
+      }
+   }
+
+   // Same logic as in formatFromFloating - note: uses the user precision.
+   //
+   cf.lowFixedLimit = EXP10 (1 - LIMIT (this->precision, 0, 15));
+
+   if (this->addUnits && !this->dbEgu.isEmpty () && (this->format != QE::Time)) {
+      cf.unitsSuffix = QString (" ") + this->dbEgu;
+   } else {
+      cf.unitsSuffix.clear ();
+   }
+
+   cf.valid = true;
+}
+
 //------------------------------------------------------------------------------
 //
 bool QEStringFormatting::useScientificNotation (const double value) const
@@ -1025,14 +1386,10 @@ bool QEStringFormatting::useScientificNotation (const double value) const
    if (this->notation == QE::Scientific) return true;
 
    // Pick best/most approptiate notation based on the value.
-   // This is athe same logic as in formatFromFloating
-   // Extact precision being used.
-   //
-   const int prec = LIMIT (this->precision, 0, 15);
-
    // Example, if prec = 3, when low limit is 0.01
+   // The low limit is pre-computed by compileFormat.
    //
-   const double lowFixedLimit = EXP10 (1 - prec);
+   const double lowFixedLimit = this->compiled.lowFixedLimit;
    const double highFixedLimit = 1.0E+05;
 
    // Work with the absolute value
@@ -1045,47 +1402,107 @@ bool QEStringFormatting::useScientificNotation (const double value) const
 }
 
 //------------------------------------------------------------------------------
-// We could template floating to/from string if ever needs be.
+// Fixed point representation using integer arithmetic, i.e. the value is
+// scaled by radix ^ precision, rounded and the digits extracted from the
+// whole and fraction parts. This avoids a pow/floor per digit.
 //
-QString QEStringFormatting::toString (const double value) const
+int QEStringFormatting::fixedImage (char* buffer, const double absValue) const
 {
-   // Some of these could be pre-computed once.
+   const NumericFormat& cf = this->compiled;    // alias
+
+   if (cf.fixedDivisor == 0) return -1;
+
+   // Round up by half the value of the least significant digit.
    //
-   const QString sign = (value < 0.0) ? "-" : (this->forceSign ? "+" : "");
-   const int zeros = LIMIT (this->leadingZeros, 0, 64);
-   const char sepChar = separatorChars[this->separator];
-   const int gap = (this->separator == QE::NoSeparator) ? -1 : separatorGaps[this->radixBase];
+   const double scaled = absValue * cf.fixedScale + 0.5;
+   if (!(scaled < double (MAX_EXACT_INTEGER))) return -1;
 
-   const int prec = LIMIT (this->useDbPrecision ? this->dbPrecision : this->precision, 0, 64);
+   const quint64 radix = quint64 (this->radixBase);
+   const quint64 total = quint64 (scaled);
+   quint64 whole = total / cf.fixedDivisor;
+   quint64 fraction = total % cf.fixedDivisor;
 
-   // Sanity checks/specials.
+   // Whole part digits, least significant first, padded with leading zeros.
+   // 53 bits in base 2 or 64 leading zeros max.
    //
-   if (QEPlatform::isNaN (value)) {
-      return "nan";
+   char wholeDigits[72];
+   int number = 0;
+   do {
+      wholeDigits[number++] = radixChars[whole % radix];
+      whole /= radix;
+   } while (whole != 0);
+
+   while (number < cf.zeros) {
+      wholeDigits[number++] = '0';
    }
 
-   if (QEPlatform::isInf (value)) {
-      return sign + "inf";
+   int p = 0;
+   for (int n = number - 1; n >= 0; n--) {
+      buffer[p++] = wholeDigits[n];
+      if ((n > 0) && (cf.gap > 0) && ((n % cf.gap) == 0)) {
+         buffer[p++] = cf.sepChar;
+      }
    }
 
-   QString result = "";
+   if (cf.precision > 0) {
+      buffer[p++] = '.';
 
-   // Do leading sign if needed or requested.
+      // Fill in the fraction digits backwards, allowing for the separators.
+      //
+      for (int j = cf.precision; j >= 1; j--) {
+         const int offset = (cf.gap > 0) ? (j - 1) + (j - 1) / cf.gap : j - 1;
+         buffer[p + offset] = radixChars[fraction % radix];
+         fraction /= radix;
+
+         if ((cf.gap > 0) && ((j % cf.gap) == 0) && (j < cf.precision)) {
+            buffer[p + offset + 1] = cf.sepChar;
+         }
+      }
+      p += (cf.gap > 0) ? cf.precision + (cf.precision - 1) / cf.gap : cf.precision;
+   }
+
+   return p;
+}
+
+//------------------------------------------------------------------------------
+// We could template floating to/from string if ever needs be.
+//
+int QEStringFormatting::floatingImage (char* buffer, const double value) const
+{
+   const NumericFormat& cf = this->compiled;    // alias
+
+   const int zeros = cf.zeros;
+   const char sepChar = cf.sepChar;
+   const int gap = cf.gap;
+   const int prec = cf.precision;
+
+   int p = 0;
+
+   // Sanity checks/specials.
    //
-   result.append (sign);
+   if (QEPlatform::isNaN (value)) {
+      memcpy (buffer, "nan", 3);
+      return 3;
+   }
 
-   // Is a radix prefix required?
+   // Do leading sign if needed or requested.
    //
-   if (this->useRadixPrefix && (this->radixBase != 10)) {
-      // Yes - do prefix.
-      //
-      if (this->radixBase == 16) {
-         result.append ("0x");
-      } else {
-         result.append (QString ("%1#").arg (this->radixBase));
-      }
+   if (value < 0.0) {
+      buffer[p++] = '-';
+   } else if (cf.signChar) {
+      buffer[p++] = cf.signChar;
    }
 
+   if (QEPlatform::isInf (value)) {
+      memcpy (&buffer[p], "inf", 3);
+      return p + 3;
+   }
+
+   // Do radix prefix if required.
+   //
+   memcpy (&buffer[p], cf.prefix, cf.prefixLength);
+   p += cf.prefixLength;
+
    double work = ABS (value);   // working value
    const double dblRadix = this->radixBase;
 
@@ -1112,8 +1529,7 @@ QString QEStringFormatting::toString (const double value) const
 
          // Round up by half the value of the least significant digit.
          //
-         const double roundUp = pow ((1.0 / dblRadix), prec) * 0.5;
-         work = work + roundUp;
+         work = work + cf.roundUp;
 
          // Check if the round up pushed us into the next radix-decade?
          //
@@ -1126,23 +1542,23 @@ QString QEStringFormatting::toString (const double value) const
       // Leading zeros
       for (int j = zeros; j >= 2; j--) {
          if ((gap > 0) && ((j % gap) == 0) && (j < zeros)) {
-            result.append (sepChar);
+            buffer[p++] = sepChar;
          }
-         result.append ('0');
+         buffer[p++] = '0';
       }
 
       int r = int (work);   // rounds down towards zero
-      result.append (radixChars[r]);
+      buffer[p++] = radixChars[r];
 
       if (prec > 0) {
-         result.append ('.');
+         buffer[p++] = '.';
          for (int j = 1; j <= prec; j++) {
             work = dblRadix * (work - r);
             r = int (work);
-            result.append (radixChars[r]);
+            buffer[p++] = radixChars[r];
 
             if ((gap > 0) && ((j % gap) == 0) && (j < prec)) {
-               result.append (sepChar);
+               buffer[p++] = sepChar;
             }
          }
       }
@@ -1150,21 +1566,24 @@ QString QEStringFormatting::toString (const double value) const
       // Now do the exponent.
       // Be consistant with toFloatingValue re selection of e vs. p
       //
-      char xp[20];
       if (this->radixBase >= 11) {
-         snprintf (xp, sizeof (xp), "p%+03d", exponent);
+         p += snprintf (&buffer[p], 20, "p%+03d", exponent);
       } else {
-         snprintf (xp, sizeof (xp), "e%+03d", exponent);
+         p += snprintf (&buffer[p], 20, "e%+03d", exponent);
       }
-      result.append (xp);
 
    } else {
       // Fixed point representation.
+      // Use the integer arithmetic algorithm when we can.
       //
+      const int length = this->fixedImage (&buffer[p], work);
+      if (length >= 0) {
+         return p + length;
+      }
+
       // Round up by half the value of the least significant digit.
       //
-      const double roundUp = pow ((1.0 / dblRadix), prec) * 0.5;
-      work = work + roundUp;
+      work = work + cf.roundUp;
 
       // Find most significant digit position.
       // Units are 0, tens are 1, etc.
@@ -1178,18 +1597,13 @@ QString QEStringFormatting::toString (const double value) const
          }
       }
 
-      // Alternative - how expensive is pow?
-      // for (int t = dblRadix; t < work; t = t*dblRadix) {
-      //    mostSig++;
-      // }
-
       mostSig = MAX (mostSig, zeros - 1);
       for (int n = mostSig; n >= -prec; n--) {
          double prs = pow (dblRadix, n);
          int r = int (floor (work / prs));
          work = work - r * prs;
 
-         result.append (radixChars[r]);
+         buffer[p++] = radixChars[r];
 
          // All done?
          //
@@ -1197,14 +1611,25 @@ QString QEStringFormatting::toString (const double value) const
             break;
 
          if (n == 0) {
-            result.append ('.');
+            buffer[p++] = '.';
          } else if ((gap > 0) && (ABS (n) % gap) == 0) {
-            result.append (sepChar);
+            buffer[p++] = sepChar;
          }
       }
    }
 
-   return result;
+   return p;
+}
+
+//------------------------------------------------------------------------------
+//
+QString QEStringFormatting::toString (const double value) const
+{
+   if (!this->compiled.valid) this->compileFormat ();
+
+   char image[ImageSize];
+   const int length = this->floatingImage (image, value);
+   return QString::fromLatin1 (image, length);
 }
 
 //------------------------------------------------------------------------------
@@ -1322,64 +1747,68 @@ double QEStringFormatting::toDouble (const QString& image, bool& okay) const
 //------------------------------------------------------------------------------
 //
 template<typename Number>
-QString QEStringFormatting::toIntegerStringGeneric (const Number value) const
+int QEStringFormatting::integerImage (char* buffer, const Number value) const
 {
-   // Some of these could be pre-computed once.
-   //
-   const QString sign = (value < 0) ? "-" : (this->forceSign ? "+" : "");
-   const int zeros = LIMIT (this->leadingZeros, 0, 64);
-   const char sepChar = separatorChars[this->separator];
-   const int gap = (this->separator == QE::NoSeparator) ? -1 : separatorGaps[this->radixBase];
+   const NumericFormat& cf = this->compiled;    // alias
 
-   // Big enough for a 64 bit integer on base 2 plus separators, sign and nn#
+   // Big enough for a 64 bit integer on base 2 plus separators.
    // Given zeros are allowed upto 64, then 86 required for decimal.
    // Plus some for any extra I haven't thought about.
    //
    char work[96];
-   int p = sizeof (work);
-   work[--p] = '\0';            // Fill work in backwards
+   int q = sizeof (work);       // Fill work in backwards
 
    int n = 0;                   // Number of digits so far - excluding separators
-   Number t = value;              // Working value
+   Number t = value;            // Working value
    do {
-      Number q = t / this->radixBase;
+      Number d = t / this->radixBase;
       Number r = t % this->radixBase;
 
       if (r < 0)
          r = -r;
 
-      work[--p] = radixChars[r];
+      work[--q] = radixChars[r];
       n++;
 
       // Add the separator char if needs be.
       //
-      if ((gap > 0) && (n % gap == 0))
-         work[--p] = sepChar;
+      if ((cf.gap > 0) && (n % cf.gap == 0))
+         work[--q] = cf.sepChar;
 
-      t = q;
-   } while ((t != 0 || n < zeros) && (p > 0));
+      t = d;
+   } while ((t != 0 || n < cf.zeros) && (q > 1));
 
-   if (work[p] == sepChar) {
-      p++;                      // no leading separator wanted
+   if (work[q] == cf.sepChar) {
+      q++;                      // no leading separator wanted
    }
 
-   // Do we need to add the radix prefix?
-   //
-   if (this->useRadixPrefix && (this->radixBase != 10)) {
-      // Do the prefix, note the special for base 16.
-      //
-      if (this->radixBase == 16) {
-         // We can't but the 0x directly in the string as %1 becomes %10
-         //
-         return QString ("%1%2%3").arg (sign).arg ("0x").arg (&work[p]);
-      } else {
-         return QString ("%1%2#%3").arg (sign).arg (this->radixBase).arg (&work[p]);
-      }
+   int p = 0;
+   if (value < 0) {
+      buffer[p++] = '-';
+   } else if (cf.signChar) {
+      buffer[p++] = cf.signChar;
    }
 
-   // No radix prefix
+   // Do we need to add the radix prefix?
    //
-   return QString ("%1%2").arg (sign).arg (&work[p]);
+   memcpy (&buffer[p], cf.prefix, cf.prefixLength);
+   p += cf.prefixLength;
+
+   const int length = int (sizeof (work)) - q;
+   memcpy (&buffer[p], &work[q], length);
+   return p + length;
+}
+
+//------------------------------------------------------------------------------
+//
+template<typename Number>
+QString QEStringFormatting::toIntegerStringGeneric (const Number value) const
+{
+   if (!this->compiled.valid) this->compileFormat ();
+
+   char image[ImageSize];
+   const int length = this->integerImage <Number> (image, value);
+   return QString::fromLatin1 (image, length);
 }
 
 //------------------------------------------------------------------------------
@@ -29,6 +29,7 @@
 #ifndef QE_STRING_FORMATTING_H
 #define QE_STRING_FORMATTING_H
 
+#include <QByteArray>
 #include <QVariant>
 #include <QString>
 #include <QStringList>
@@ -98,6 +99,14 @@ public:
    bool getUseRadixPrefix () const;
    int getLeadingZeros () const;
 
+   // Returns the smallest change in a numeric value that is (nominally) visible
+   // when formatted, i.e. half of the least significant displayed digit, based
+   // on the effective precision and radix. Returns 0.0 if this can't be determined,
+   // e.g. for scientific/automatic notation or non-numeric formats.
+   // This is used to derive an automatic deadband.
+   //
+   double getResolution () const;
+
    // Primative conversion functions.
    // While these are primarily intended for use internally, they have
    // be made public as may be useful to bespoke applications and plugins.
@@ -134,11 +143,38 @@ private:
    //
    void determineDbFormat (const QVariant& value) const;
 
+   // Pre-computes the numeric formatting options (see NumericFormat below).
+   // Called on demand after any of the relevant options have changed.
+   //
+   void compileFormat () const;
+
+   // Write the image of a number into the buffer, which must be at least
+   // ImageSize chars long, and return the image length (no zero terminator).
+   //
+   int floatingImage (char* buffer, const double value) const;
+
+   // Fixed point image fast path - returns -1 if value out of range.
+   //
+   int fixedImage (char* buffer, const double absValue) const;
+
+   // Formats vector variants directly, i.e. without conversion to a QVariantList.
+   // Returns false if not handled, e.g. enumerations, string or time formats.
+   //
+   bool appendVectorImages (const QVariant& value, QString& result) const;
+   void asciiVectorImage (const QVariant& value, QString& result) const;
+
    // These templates are private - only instatiated internally.
    //
+   template<typename Number>
+   int integerImage (char* buffer, const Number) const;
+
    template<typename Number>
    QString toIntegerStringGeneric (const Number) const;
 
+   template<typename Element>
+   void appendElementImages (const QVector<Element>& data,
+                             const QE::Formats elementFormat) const;
+
    template<typename Number>
    Number toIntegerValueGeneric (const QString& image, bool& okay) const;
 
@@ -152,6 +188,36 @@ private:
    // Error reporting
    QString formatFailure (const QString message) const;
 
+   // Large enough for a base 2 image of the largest double value including
+   // separators, leading zeros, precision, sign, radix prefix and exponent.
+   //
+   enum Constants { ImageSize = 1600 };
+
+   // Numeric formatting options compiled from the formatting configuration and
+   // database information, i.e. once per property change as opposed to once
+   // per value formatted.
+   //
+   struct NumericFormat {
+      bool valid;                // false when any option has changed
+      int precision;             // effective precision, i.e. db or user precision
+      int zeros;                 // number of leading zeros
+      int gap;                   // separator gap, -1 when no separator
+      char sepChar;              // separator character
+      char signChar;             // sign char for non-negative values, '+' or 0
+      char prefix [8];           // radix prefix, e.g. "0x" or "8#", may be empty
+      int prefixLength;
+      double roundUp;            // half the value of the least significant digit
+      double fixedScale;         // radix ^ precision
+      quint64 fixedDivisor;      // radix ^ precision as an integer, 0 when too large
+      double lowFixedLimit;      // automatic notation lower fixed point limit
+      QString unitsSuffix;       // " egu" when units are required, else empty
+   };
+   mutable NumericFormat compiled;
+
+   // Reusable buffer for array images.
+   //
+   mutable QByteArray imageBuffer;
+
    // Formatted output string
    mutable QE::Formats dbFormat; // Format determined from read value (Floating, integer, etc).
    mutable bool dbFormatArray;   // True if read value is an array
@@ -36,6 +36,9 @@ SOURCES += $$PWD/QCaConnectionInfo.cpp
 HEADERS += $$PWD/QCaDataPoint.h
 SOURCES += $$PWD/QCaDataPoint.cpp
 
+HEADERS += $$PWD/QCaDataPointStatistics.h
+SOURCES += $$PWD/QCaDataPointStatistics.cpp
+
 HEADERS += $$PWD/QCaDateTime.h
 SOURCES += $$PWD/QCaDateTime.cpp
 
@@ -27,8 +27,14 @@
 #include "QECaClient.h"
 #include <QApplication>
 #include <QDebug>
+#include <QMutexLocker>
 #include <QTimer>
+#include <limits>
+#include <string.h>
+#include <cadef.h>
 #include <acai_version.h>
+#include <QEAdaptationParameters.h>
+#include <QECommon.h>
 #include <QEPvNameUri.h>
 #include <QERecordFieldName.h>
 #include <QEVectorVariants.h>
@@ -102,6 +108,7 @@ QECaClient::QECaClient (const QString& pvNameIn,
    mainClient (new QE_ACAI_Client (pvNameIn, this))
 {
    this->descClient = NULL;     // we don't create unless requested.
+   this->pvDataCacheIsValid = false;
    QECaClientManager::initialise ();   // idempotent
 }
 
@@ -216,8 +223,59 @@ const void* QECaClient::getRawDataPointer (size_t& count,
 }
 
 //------------------------------------------------------------------------------
+// Forms a vector variant from the raw data using a bulk copy. The VectorType
+// element type must match the CA data field type, e.g. QEInt16Vector for SHORT.
+// If the element sizes do not match (this should not happen), we fall back
+// to an element by element conversion.
+//
+template <typename VectorType>
+QVariant QECaClient::getVectorVariant (const unsigned int number) const
+{
+   typedef typename VectorType::value_type ElementType;
+
+   VectorType vector;
+   size_t byteCount = 0;
+   const void* rawData = this->mainClient->rawDataPointer (byteCount, 0);
+
+   if (rawData && (this->getDataElementSize () == sizeof (ElementType))) {
+      const unsigned int available = (unsigned int) (byteCount / sizeof (ElementType));
+      const unsigned int n = MIN (number, available);
+      vector.resize (n);
+      memcpy (vector.data (), rawData, n * sizeof (ElementType));
+
+   } else if (std::numeric_limits<ElementType>::is_integer) {
+      vector.resize (number);
+      for (unsigned int j = 0; j < number; j++) {
+         vector [j] = ElementType (this->mainClient->getInteger (j));
+      }
+
+   } else {
+      vector.resize (number);
+      for (unsigned int j = 0; j < number; j++) {
+         vector [j] = ElementType (this->mainClient->getFloating (j));
+      }
+   }
+
+   return QVariant::fromValue (vector);
+}
+
+//------------------------------------------------------------------------------
+// The converted data is cached until the next update, so that when shared by
+// several QCaObjects (or requested several times by the one QCaObject) the
+// conversion is only done once per update.
 //
 QVariant QECaClient::getPvData () const
+{
+   if (!this->pvDataCacheIsValid) {
+      this->pvDataCache = this->convertPvData ();
+      this->pvDataCacheIsValid = true;
+   }
+   return this->pvDataCache;
+}
+
+//------------------------------------------------------------------------------
+//
+QVariant QECaClient::convertPvData () const
 {
    QVariant result = QVariant (QVariant::Invalid);  // default
 
@@ -265,44 +323,50 @@ QVariant QECaClient::getPvData () const
       }
 
    } else {
-      // Treat as an array
-      // Consider using own QEVectorVariants
+      // Treat as an array.
+      // Numeric arrays are delivered as one of our own vector variants, bulk
+      // copied from the raw data. This avoids creating a variant per element.
       //
-      QVariantList list;
-
       switch (fieldType) {
 
          case ACAI::ClientFieldSTRING:
-            for (unsigned int j = 0; j < number; j++) {
-               list.append (QVariant (QString::fromStdString (this->mainClient->getString (j))));
+            {
+               QVariantList list;
+               list.reserve (number);
+               for (unsigned int j = 0; j < number; j++) {
+                  list.append (QVariant (QString::fromStdString (this->mainClient->getString (j))));
+               }
+               result = list;
             }
             break;
 
          case ACAI::ClientFieldCHAR:
-            for (unsigned int j = 0; j < number; j++) {
-               list.append (QVariant (qlonglong (this->mainClient->getInteger (j))));
-            }
+            result = this->getVectorVariant<QEUint8Vector> (number);
             break;
 
          case ACAI::ClientFieldENUM:
+            result = this->getVectorVariant<QEUint16Vector> (number);
+            break;
+
          case ACAI::ClientFieldSHORT:
+            result = this->getVectorVariant<QEInt16Vector> (number);
+            break;
+
          case ACAI::ClientFieldLONG:
-            for (unsigned int j = 0; j < number; j++) {
-               list.append (QVariant (qlonglong (this->mainClient->getInteger (j))));
-            }
+            result = this->getVectorVariant<QEInt32Vector> (number);
             break;
 
          case ACAI::ClientFieldFLOAT:
+            result = this->getVectorVariant<QEFloatVector> (number);
+            break;
+
          case ACAI::ClientFieldDOUBLE:
-            for (unsigned int j = 0; j < number; j++) {
-               list.append (QVariant (this->mainClient->getFloating (j)));
-            }
+            result = this->getVectorVariant<QEDoubleVector> (number);
             break;
 
          default:
             break;
       }
-      result = list;
    }
 
    return result;
@@ -337,7 +401,7 @@ bool QECaClient::putPvData (const QVariant& value)
       // NOTE: requires acai 1-5-8 orlater.
       result = this->mainClient->putByteArray ((void*) bytes.constData (), bytes.size());
    }
-   else if (vtype != QVariant::List) {
+   else if ((vtype != QVariant::List) && !QEVectorVariants::isVectorVariant (value)) {
       // Process as scaler
       //
       ACAI::ClientInteger i;
@@ -393,9 +457,65 @@ bool QECaClient::putPvData (const QVariant& value)
 
       extra = QString(", source type %1.").arg (value.typeName ());
 
+   } else if (QEVectorVariants::isVectorVariant (value)) {
+      // Process as own vector variant array.
+      //
+      switch (fieldType) {
+         case ACAI::ClientFieldSTRING:
+            {
+               bool okay;
+               const QVariantList valueArray = QEVectorVariants::convertToVariantList (value, okay);
+               ACAI::ClientStringArray strArray;
+               for (int j = 0; j < valueArray.count (); j++) {
+                  strArray.push_back (valueArray.value (j).toString ().toStdString ());
+               }
+               result = okay && this->mainClient->putStringArray (strArray);
+            }
+            break;
+
+         case ACAI::ClientFieldENUM:
+         case ACAI::ClientFieldCHAR:
+         case ACAI::ClientFieldSHORT:
+         case ACAI::ClientFieldLONG:
+            {
+               bool okay;
+               const QVector<double> values = QEVectorVariants::convertToFloatingVector (value, okay);
+               const double min = this->mainClient->minFieldValue();
+               const double max = this->mainClient->maxFieldValue();
+               ACAI::ClientIntegerArray intArray;
+               intArray.reserve (values.count ());
+               for (int j = 0; j < values.count (); j++) {
+                  const double f = values.value (j);
+                  if ((f < min) || (f > max)) {
+                     valueInRange = false;
+                     break;
+                  }
+                  intArray.push_back (static_cast<ACAI::ClientInteger> (f));
+               }
+               result = okay && valueInRange && this->mainClient->putIntegerArray (intArray);
+            }
+            break;
+
+         case ACAI::ClientFieldFLOAT:
+         case ACAI::ClientFieldDOUBLE:
+            {
+               bool okay;
+               const QVector<double> values = QEVectorVariants::convertToFloatingVector (value, okay);
+               const ACAI::ClientFloatingArray fltArray (values.constBegin (), values.constEnd ());
+               result = okay && this->mainClient->putFloatingArray (fltArray);
+            }
+            break;
+
+         default:
+            result = false;
+            knownType = false;
+            break;
+      }
+
+      extra = QString(" source %1.").arg (value.typeName ());
+
    } else {
       // Process as array.
-      // Consider accepting own QEVectorVariants
       //
       const QVariantList valueArray = value.toList ();
       const int number = valueArray.count ();
@@ -684,6 +804,7 @@ unsigned QECaClient::getDataElementSize() const              { return this->main
 //
 void QECaClient::connectionUpdate (const bool isConnected)
 {
+   this->pvDataCacheIsValid = false;
    emit this->connectionUpdated (isConnected);
 }
 
@@ -691,6 +812,8 @@ void QECaClient::connectionUpdate (const bool isConnected)
 //
 void QECaClient::dataUpdate (const bool firstUpdate)
 {
+    this->pvDataCacheIsValid = false;
+    QECaClientManager::recordLatency ();
     emit this->dataUpdated (firstUpdate);
 }
 
@@ -711,6 +834,65 @@ void QECaClient::putCallbackNotifcation (const bool isSuccessful)
 //
 static QECaClientManager* singleton = NULL;
 
+// Posted to the manager when the CA library opens or closes a file descriptor.
+//
+static const QEvent::Type fdRegistrationEvent = QEvent::Type (QEvent::registerEventType ());
+
+// Follow up poll delay used in event driven mode. When CA is running with
+// preemptive callbacks enabled, the CA receive thread may not have quite
+// finished processing the incomming data when the socket activity is detected.
+//
+static const int followUpDelay = 1;   // mSec
+
+//------------------------------------------------------------------------------
+// static
+QECaClient::DispatchModes QECaClient::getDispatchMode ()
+{
+   static QECaClient::DispatchModes theDispatchMode = QECaClient::dmPolled;
+   static bool theDispatchModeIsDefined = false;
+
+   if (!theDispatchModeIsDefined) {
+      QEAdaptationParameters ap ("QE_");
+      const QString modeSpec = ap.getString ("ca_dispatch", "poll").toLower();
+
+      if (modeSpec == "event") {
+         theDispatchMode = QECaClient::dmEventDriven;
+      } else if (modeSpec == "poll") {
+         theDispatchMode = QECaClient::dmPolled;
+      } else {
+         DEBUG << "Invalid CA dispatch mode" << modeSpec << ", going with poll";
+         theDispatchMode = QECaClient::dmPolled;
+      }
+      theDispatchModeIsDefined = true;
+   }
+
+   return theDispatchMode;
+}
+
+//------------------------------------------------------------------------------
+// static
+void QECaClient::getDispatchLatency (int& count, double& mean, double& maximum,
+                                     const bool reset)
+{
+   count = 0;
+   mean = 0.0;
+   maximum = 0.0;
+
+   if (!singleton) return;
+
+   count = singleton->latencyCount;
+   if (count > 0) {
+      mean = double (singleton->latencyTotal) / double (count) / 1.0e9;
+      maximum = double (singleton->latencyMaximum) / 1.0e9;
+   }
+
+   if (reset) {
+      singleton->latencyCount = 0;
+      singleton->latencyTotal = 0;
+      singleton->latencyMaximum = 0;
+   }
+}
+
 //------------------------------------------------------------------------------
 // static
 void QECaClientManager::initialise ()
@@ -728,22 +910,89 @@ void QECaClientManager::notificationHandlers (const char* notification)
    userMessage.sendMessage (notification, message_types (MESSAGE_TYPE_ERROR));
 }
 
+//------------------------------------------------------------------------------
+// static
+void QECaClientManager::recordLatency ()
+{
+   if (!singleton) return;
+
+   qint64 latency = singleton->clock.nsecsElapsed () - singleton->referenceTime;
+   if (latency < 0) latency = 0;
+
+   singleton->latencyTotal += latency;
+   singleton->latencyMaximum = qMax (singleton->latencyMaximum, latency);
+   singleton->latencyCount++;
+}
+
+//------------------------------------------------------------------------------
+// static
+void QECaClientManager::fdRegistrationHandler (void* arg, int fd, int opened)
+{
+   QECaClientManager* manager = (QECaClientManager*) arg;
+   if (!manager) return;
+
+   {
+      QMutexLocker locker (&manager->fdMutex);
+      manager->fdChanges.append (FdRegistration (fd, opened != 0));
+   }
+
+   // Wake the main thread - postEvent is thread safe.
+   //
+   QCoreApplication::postEvent (manager, new QEvent (fdRegistrationEvent));
+}
+
 //------------------------------------------------------------------------------
 // constructor
 //
 QECaClientManager::QECaClientManager () : QObject (NULL)
 {
    this->stillRunning = true;
+   this->eventPollPending = false;
+   this->followUpPollPending = false;
+   this->dispatchMode = QECaClient::getDispatchMode ();
+
+   this->clock.start ();
+   this->referenceTime = 0;
+   this->latencyTotal = 0;
+   this->latencyMaximum = 0;
+   this->latencyCount = 0;
+
    ACAI::Client::initialise ();
    ACAI::Client::setNotificationHandler (QECaClientManager::notificationHandlers);
 
+   if (this->dispatchMode == QECaClient::dmEventDriven) {
+      // Request notification of each CA socket file descriptor as it is placed
+      // into/removed from service. Note: ACAI::Client::initialise creates and
+      // attaches to the CA context for this thread.
+      //
+      const int status = ca_add_fd_registration (QECaClientManager::fdRegistrationHandler, this);
+      if (status != ECA_NORMAL) {
+         DEBUG << "ca_add_fd_registration failed:" << ca_message (status)
+               << ", going with poll";
+         this->dispatchMode = QECaClient::dmPolled;
+      }
+   }
+
    // Connect to the about to quit signal.
    // Note: qApp is defined in QApplication
    //
    QObject::connect (qApp, SIGNAL (aboutToQuit ()),
                      this, SLOT   (aboutToQuitHandler ()));
 
-   // Schedule first poll event.
+   // Optionally report latency statistics on a regular basis.
+   //
+   QEAdaptationParameters ap ("QE_");
+   const int reportPeriod = ap.getInt ("ca_dispatch_report", 0);   // seconds
+   if (reportPeriod > 0) {
+      QTimer* reportTimer = new QTimer (this);
+      QObject::connect (reportTimer, SIGNAL (timeout ()),
+                        this,        SLOT   (reportHandler ()));
+      reportTimer->start (1000 * reportPeriod);
+   }
+
+   // Schedule first poll event. In event driven mode, we still do a regular
+   // background poll - this handles any activity not associated with socket
+   // reads, e.g. connection timeouts.
    //
    QTimer::singleShot (1, this, SLOT (timeoutHandler ()));
 }
@@ -755,10 +1004,8 @@ QECaClientManager::~QECaClientManager () { }
 
 //------------------------------------------------------------------------------
 //
-void QECaClientManager::timeoutHandler ()
+void QECaClientManager::poll ()
 {
-   if (!this->stillRunning) return;
-
    // The ACAI package requires a regular poll.
    // Catch any exceptions here.
    //
@@ -768,6 +1015,22 @@ void QECaClientManager::timeoutHandler ()
    catch (...) {
       DEBUG << ": poll exception.";
    }
+}
+
+//------------------------------------------------------------------------------
+//
+void QECaClientManager::timeoutHandler ()
+{
+   if (!this->stillRunning) return;
+
+   this->poll ();
+
+   // When polled, an update could have arrived at any time since the end of
+   // the previous poll - use this as the (worst case) latency reference.
+   //
+   if (!this->eventPollPending) {
+      this->referenceTime = this->clock.nsecsElapsed ();
+   }
 
    // Schedule another poll event - 16 mS approx 60Hz.
    // Note: the delay is relative to the end of processing the poll function.
@@ -775,11 +1038,151 @@ void QECaClientManager::timeoutHandler ()
    QTimer::singleShot (16, this, SLOT (timeoutHandler ()));
 }
 
+//------------------------------------------------------------------------------
+//
+void QECaClientManager::customEvent (QEvent* event)
+{
+   if (!event || event->type () != fdRegistrationEvent) {
+      QObject::customEvent (event);
+      return;
+   }
+
+   QList<FdRegistration> changes;
+   {
+      QMutexLocker locker (&this->fdMutex);
+      changes = this->fdChanges;
+      this->fdChanges.clear ();
+   }
+
+   for (int j = 0; j < changes.count (); j++) {
+      const int fd = changes.value (j).first;
+      const bool opened = changes.value (j).second;
+
+      // Remove any existing notifier for this file descriptor - if re-opened,
+      // the old notifier is stale.
+      //
+      QSocketNotifier* notifier = this->notifiers.take (fd);
+      if (notifier) {
+         notifier->setEnabled (false);
+         notifier->deleteLater ();
+      }
+
+      if (opened && this->stillRunning) {
+         notifier = new QSocketNotifier (fd, QSocketNotifier::Read, this);
+         // The activated signal signature differs between Qt5 and Qt6;
+         // the slot takes no arguments and uses the sender to identify
+         // the notifier.
+         //
+#if QT_VERSION < 0x060000
+         QObject::connect (notifier, SIGNAL (activated (int)),
+                           this,     SLOT   (socketActivated ()));
+#else
+         QObject::connect (notifier, SIGNAL (activated (QSocketDescriptor, QSocketNotifier::Type)),
+                           this,     SLOT   (socketActivated ()));
+#endif
+         this->notifiers.insert (fd, notifier);
+      }
+   }
+}
+
+//------------------------------------------------------------------------------
+//
+void QECaClientManager::scheduleEventPoll ()
+{
+   if (this->eventPollPending) return;
+
+   this->eventPollPending = true;
+   this->referenceTime = this->clock.nsecsElapsed ();
+   QTimer::singleShot (0, this, SLOT (eventPollHandler ()));
+}
+
+//------------------------------------------------------------------------------
+//
+void QECaClientManager::socketActivated ()
+{
+   // Socket notifiers are level triggered. Disable until we have polled,
+   // otherwise we will be re-activated until the CA library reads the socket.
+   //
+   QSocketNotifier* notifier = qobject_cast<QSocketNotifier*> (this->sender ());
+   if (notifier) notifier->setEnabled (false);
+
+   this->scheduleEventPoll ();
+}
+
+//------------------------------------------------------------------------------
+//
+void QECaClientManager::eventPoll ()
+{
+   this->poll ();
+
+   QHash<int, QSocketNotifier*>::iterator it;
+   for (it = this->notifiers.begin (); it != this->notifiers.end (); ++it) {
+      it.value ()->setEnabled (true);
+   }
+}
+
+//------------------------------------------------------------------------------
+//
+void QECaClientManager::eventPollHandler ()
+{
+   this->eventPollPending = false;
+
+   if (!this->stillRunning) return;
+
+   this->eventPoll ();
+
+   // Catch any data still being processed by the CA library when woken.
+   // At most one follow up poll is outstanding at any time.
+   //
+   if (!this->followUpPollPending) {
+      this->followUpPollPending = true;
+      QTimer::singleShot (followUpDelay, this, SLOT (followUpPollHandler ()));
+   }
+}
+
+//------------------------------------------------------------------------------
+//
+void QECaClientManager::followUpPollHandler ()
+{
+   this->followUpPollPending = false;
+
+   if (!this->stillRunning) return;
+
+   // If socket activity has already scheduled an event poll, that poll will do
+   // the job (and schedule its own follow up).
+   //
+   if (this->eventPollPending) return;
+
+   this->eventPoll ();
+}
+
+//------------------------------------------------------------------------------
+//
+void QECaClientManager::reportHandler ()
+{
+   int count;
+   double mean;
+   double maximum;
+
+   QECaClient::getDispatchLatency (count, mean, maximum, true);
+
+   DEBUG << (this->dispatchMode == QECaClient::dmEventDriven ? "event" : "poll")
+         << "updates:" << count
+         << " mean latency:" << QString::number (1000.0 * mean, 'f', 3) << "mS"
+         << " max latency:" << QString::number (1000.0 * maximum, 'f', 3) << "mS";
+}
+
 //------------------------------------------------------------------------------
 //
 void QECaClientManager::aboutToQuitHandler ()
 {
    this->stillRunning = false;
+
+   QHash<int, QSocketNotifier*>::iterator it;
+   for (it = this->notifiers.begin (); it != this->notifiers.end (); ++it) {
+      it.value ()->setEnabled (false);
+   }
+
    ACAI::Client::finalise ();
 }
 
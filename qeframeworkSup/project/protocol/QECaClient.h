@@ -30,6 +30,13 @@
 #include <acai_client_types.h>
 #include <acai_client.h>
 
+#include <QElapsedTimer>
+#include <QEvent>
+#include <QHash>
+#include <QList>
+#include <QMutex>
+#include <QPair>
+#include <QSocketNotifier>
 #include <QEBaseClient.h>
 #include <QCaAlarmInfo.h>
 #include <QCaDateTime.h>
@@ -48,6 +55,15 @@ class QE_FRAMEWORK_LIBRARY_SHARED_EXPORT QECaClient :
 {
    Q_OBJECT
 public:
+   // Channel Access callback dispatch modes.
+   // The mode is selected once per application using the ca_dispatch adaptation
+   // parameter, i.e. --ca_dispatch=event, QE_CA_DISPATCH=poll etc.
+   //
+   enum DispatchModes {
+      dmPolled,        // ACAI library polled every 16 mS (the default).
+      dmEventDriven    // ACAI library polled as soon as CA socket activity detected.
+   };
+
    explicit QECaClient (const QString& pvName,
                         QObject* parent);
    ~QECaClient ();
@@ -94,6 +110,20 @@ public:
    unsigned getDataElementSize() const;
    const void* getRawDataPointer (size_t& count, const size_t offset = 0) const;
 
+   // Returns the dispatch mode in use.
+   //
+   static DispatchModes getDispatchMode ();
+
+   // Provides update-to-signal latency statistics, i.e. the time (in seconds) from
+   // when an update is known to be available to when the dataUpdated signal is
+   // emitted. When using polled mode, the reference time is the end of the
+   // previous poll, so this is an upper bound. When using event driven mode,
+   // the reference time is the time socket activity was detected.
+   // When reset is true, the statistics are reset after being read.
+   //
+   static void getDispatchLatency (int& count, double& mean, double& maximum,
+                                   const bool reset = false);
+
 protected:
    // Called by QE_ACAI_Client.
    //
@@ -110,6 +140,14 @@ private:
    bool varientToInteger (const QVariant& qValue, ACAI::ClientInteger& iValue, bool& valueInRange);
    bool varientToEnumIndex (const QVariant& qValue, ACAI::ClientInteger& index, bool& valueInRange);
 
+   template <typename VectorType>
+   QVariant getVectorVariant (const unsigned int number) const;
+
+   QVariant convertPvData () const;
+
+   mutable QVariant pvDataCache;
+   mutable bool pvDataCacheIsValid;
+
    QE_ACAI_Client* mainClient;    // Typically but not necessarily .VAL field.
    QE_ACAI_Client* descClient;    // connects to the .DESC field (when needed).
 
@@ -137,13 +175,52 @@ private:
    //
    static void initialise ();
 
+   // Called by QECaClient::dataUpdate in order to accumulate latency statistics.
+   //
+   static void recordLatency ();
+
+   // Receives the posted file descriptor registration change events.
+   //
+   void customEvent (QEvent* event);
+
 private:
    // Not used directly, set pass as a parameter.
    static void notificationHandlers (const char* notification);
 
+   // Not used directly, passed to ca_add_fd_registration. This may be called
+   // from a CA library thread - it queues the change and wakes the main thread.
+   //
+   static void fdRegistrationHandler (void* arg, int fd, int opened);
+
+   void poll ();
+   void eventPoll ();
+   void scheduleEventPoll ();
+
+   typedef QPair<int, bool> FdRegistration;    // file descriptor, opened
+
+   QECaClient::DispatchModes dispatchMode;
    bool stillRunning;
+   bool eventPollPending;
+   bool followUpPollPending;
+
+   QMutex fdMutex;                              // protects fdChanges
+   QList<FdRegistration> fdChanges;
+   QHash<int, QSocketNotifier*> notifiers;      // only accessed by main thread
+
+   // Latency statistics - all in nSec.
+   //
+   QElapsedTimer clock;
+   qint64 referenceTime;
+   qint64 latencyTotal;
+   qint64 latencyMaximum;
+   int latencyCount;
+
 private slots:
    void timeoutHandler ();
+   void eventPollHandler ();
+   void followUpPollHandler ();
+   void socketActivated ();
+   void reportHandler ();
    void aboutToQuitHandler ();
 
    friend class QECaClient;
@@ -0,0 +1,193 @@
+/*  QEChannelRegistry.cpp
+ *
+ *  This file is part of the EPICS QT Framework, initially developed at the
+ *  Australian Synchrotron.
+ *
+ *  Copyright (C) 2024 The EPICS QT Framework contributors.
+ *
+ *  The EPICS QT Framework is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  The EPICS QT Framework is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with the EPICS QT Framework.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "QEChannelRegistry.h"
+#include <QDebug>
+#include <QEAdaptationParameters.h>
+#include <QECaClient.h>
+#include <QEPvaClient.h>
+
+#define DEBUG qDebug () << "QEChannelRegistry" << __LINE__ << __FUNCTION__ << "  "
+
+QEChannelRegistry::KeyMaps QEChannelRegistry::keyMap;
+QEChannelRegistry::ClientMaps QEChannelRegistry::clientMap;
+
+//------------------------------------------------------------------------------
+// place holders
+QEChannelRegistry::QEChannelRegistry () { }
+QEChannelRegistry::~QEChannelRegistry () { }
+
+//------------------------------------------------------------------------------
+// static
+bool QEChannelRegistry::isEnabled ()
+{
+   static bool theSharingIsEnabled = true;
+   static bool theSharingIsDefined = false;
+
+   if (!theSharingIsDefined) {
+      QEAdaptationParameters ap ("QE_");
+      theSharingIsEnabled = !ap.getBool ("disable_channel_sharing");
+      theSharingIsDefined = true;
+   }
+
+   return theSharingIsEnabled;
+}
+
+//------------------------------------------------------------------------------
+// static
+QString QEChannelRegistry::makeKey (const QEPvNameUri& uri,
+                                    const unsigned int elementCount,
+                                    const unsigned int priority)
+{
+   return QString ("%1#%2#%3").arg (uri.encodeUri ()).arg (elementCount).arg (priority);
+}
+
+//------------------------------------------------------------------------------
+// static
+QEBaseClient* QEChannelRegistry::attach (const QEPvNameUri& uri,
+                                         const unsigned int elementCount,
+                                         const unsigned int priority)
+{
+   const QString key = QEChannelRegistry::makeKey (uri, elementCount, priority);
+
+   Entry* entry = QEChannelRegistry::keyMap.value (key, NULL);
+   if (entry) {
+      entry->attachCount++;
+      return entry->client;
+   }
+
+   // First user - create the client. Shared clients do not have a parent.
+   //
+   QEBaseClient* client = NULL;
+   QECaClient* caClient = NULL;
+   QEPvaClient* pvaClient = NULL;
+
+   switch (uri.getProtocol ()) {
+      case QEPvNameUri::ca:
+         client = caClient = new QECaClient (uri.getPvName (), NULL);
+         caClient->setPriority (priority);
+         if (elementCount > 0) {
+            caClient->setRequestCount (elementCount);
+         }
+         break;
+
+      case QEPvNameUri::pva:
+         client = pvaClient = new QEPvaClient (uri.getPvName (), NULL);
+         pvaClient->setPvRequest (uri.getPvRequest ());
+         break;
+
+      default:
+         return NULL;
+   }
+
+   entry = new Entry;
+   entry->key = key;
+   entry->client = client;
+   entry->attachCount = 1;
+   entry->openCount = 0;
+   entry->openStatus = false;
+
+   QEChannelRegistry::keyMap.insert (key, entry);
+   QEChannelRegistry::clientMap.insert (client, entry);
+
+   return client;
+}
+
+//------------------------------------------------------------------------------
+// static
+void QEChannelRegistry::detach (QEBaseClient* client)
+{
+   Entry* entry = QEChannelRegistry::clientMap.value (client, NULL);
+   if (!entry) {
+      DEBUG << "unregistered client";
+      return;
+   }
+
+   entry->attachCount--;
+   if (entry->attachCount > 0) return;
+
+   // Last user has detached.
+   //
+   QEChannelRegistry::keyMap.remove (entry->key);
+   QEChannelRegistry::clientMap.remove (client);
+
+   client->closeChannel ();
+
+   // We may be within the client's own signal emission, so defer the delete.
+   //
+   client->deleteLater ();
+   delete entry;
+}
+
+//------------------------------------------------------------------------------
+// static
+bool QEChannelRegistry::openChannel (QEBaseClient* client)
+{
+   Entry* entry = QEChannelRegistry::clientMap.value (client, NULL);
+   if (!entry) {
+      DEBUG << "unregistered client";
+      return false;
+   }
+
+   entry->openCount++;
+   if (entry->openCount == 1) {
+      entry->openStatus = client->openChannel (QEBaseClient::Monitor | QEBaseClient::Write);
+   }
+
+   return entry->openStatus;
+}
+
+//------------------------------------------------------------------------------
+// static
+void QEChannelRegistry::closeChannel (QEBaseClient* client)
+{
+   Entry* entry = QEChannelRegistry::clientMap.value (client, NULL);
+   if (!entry) {
+      DEBUG << "unregistered client";
+      return;
+   }
+
+   if (entry->openCount <= 0) return;   // sanity check
+
+   entry->openCount--;
+   if (entry->openCount == 0) {
+      client->closeChannel ();
+      entry->openStatus = false;
+   }
+}
+
+//------------------------------------------------------------------------------
+// static
+int QEChannelRegistry::attachedCount (QEBaseClient* client)
+{
+   Entry* entry = QEChannelRegistry::clientMap.value (client, NULL);
+   return entry ? entry->attachCount : 0;
+}
+
+//------------------------------------------------------------------------------
+// static
+int QEChannelRegistry::clientCount ()
+{
+   return QEChannelRegistry::keyMap.count ();
+}
+
+// end
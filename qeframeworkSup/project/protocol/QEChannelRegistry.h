@@ -0,0 +1,101 @@
+/*  QEChannelRegistry.h
+ *
+ *  This file is part of the EPICS QT Framework, initially developed at the
+ *  Australian Synchrotron.
+ *
+ *  Copyright (C) 2024 The EPICS QT Framework contributors.
+ *
+ *  The EPICS QT Framework is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  The EPICS QT Framework is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with the EPICS QT Framework.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef QE_CHANNEL_REGISTRY_H
+#define QE_CHANNEL_REGISTRY_H
+
+#include <QHash>
+#include <QString>
+#include <QEBaseClient.h>
+#include <QEPvNameUri.h>
+#include <QEFrameworkLibraryGlobal.h>
+
+/// This class provides a process wide, reference counted, registry of shared
+/// CA and PVA clients. Clients are keyed by the decoded PV name URI, including any
+/// pva request, together with the request options, i.e. element count and priority.
+/// Multiple QCaObjects may attach to the one client, which in turn opens just the
+/// one channel.
+///
+/// Shared clients are owned by the registry, and are only ever opened in
+/// subscribe (monitor plus write) mode.
+///
+/// Sharing may be disabled using the disable_channel_sharing adaptation parameter.
+///
+/// Note: this class is intended to be used by QCaObject. The functions must
+/// only be called from the main thread.
+///
+class QE_FRAMEWORK_LIBRARY_SHARED_EXPORT QEChannelRegistry {
+public:
+   // Returns true if channel sharing is enabled.
+   //
+   static bool isEnabled ();
+
+   // Attach to a client, creating if needs be. Returns NULL if the protocol
+   // is not supported. Each attach must be matched by a detach.
+   //
+   static QEBaseClient* attach (const QEPvNameUri& uri,
+                                const unsigned int elementCount,
+                                const unsigned int priority);
+
+   // Detach from the client. When the last user detaches, the client's
+   // channel is closed and the client is deleted.
+   //
+   static void detach (QEBaseClient* client);
+
+   // Reference counted channel open/close. The channel is opened on the first
+   // open and closed on the last close. Returns the open status.
+   //
+   static bool openChannel (QEBaseClient* client);
+   static void closeChannel (QEBaseClient* client);
+
+   // Returns number of users attached to the client, 0 if not a registered client.
+   //
+   static int attachedCount (QEBaseClient* client);
+
+   // Returns number of currently registered (i.e. shared) clients.
+   //
+   static int clientCount ();
+
+private:
+   explicit QEChannelRegistry ();
+   ~QEChannelRegistry ();
+
+   static QString makeKey (const QEPvNameUri& uri,
+                           const unsigned int elementCount,
+                           const unsigned int priority);
+
+   struct Entry {
+      QString key;
+      QEBaseClient* client;
+      int attachCount;
+      int openCount;
+      bool openStatus;
+   };
+
+   typedef QHash<QString, Entry*> KeyMaps;
+   typedef QHash<QEBaseClient*, Entry*> ClientMaps;
+
+   static KeyMaps keyMap;
+   static ClientMaps clientMap;
+};
+
+#endif // QE_CHANNEL_REGISTRY_H
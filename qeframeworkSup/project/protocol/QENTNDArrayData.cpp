@@ -27,6 +27,11 @@
 #include "QENTNDArrayData.h"
 #include <QEPvaData.h>
 #include <QString>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QAtomicInt>
+#include <QThread>
+#include <QEAdaptationParameters.h>
 
 // Do we need support for decpmpression?
 //
@@ -64,6 +69,41 @@
 
 #define DEBUG qDebug() << "QENTNDArrayData" << __LINE__ << __FUNCTION__ << "  "
 
+// Recycled decompression output buffers. Decompression may occur on worker
+// threads, hence the mutex.
+//
+#define MAXIMUM_POOLED_BUFFERS   8
+
+static QMutex bufferPoolMutex;
+static QList<QByteArray> bufferPool;
+
+// Number of recent attribute caches retained for re-use.
+//
+#define MAXIMUM_ATTRIBUTE_CACHES   8
+
+//------------------------------------------------------------------------------
+// Frames, and copies of frames, that share an attribute array share the one cache
+// so that attributes are parsed at most once. Attributes may be accessed from any
+// thread, hence the mutex.
+//
+class QENTNDArrayData::AttributeCache {
+public:
+   AttributeCache () : isParsed (false), format (QE::Mono) { }
+
+   QMutex mutex;
+   bool isParsed;
+   AttributeMaps attributeMap;
+   QE::ImageFormatOptions format;
+
+#ifdef QE_INCLUDE_PV_ACCESS
+   // The frozen, i.e. immutable, attribute array.
+   //
+   epics::pvData::PVStructureArray::const_svector attributes;
+
+   void parse ();   // caller must hold the mutex
+#endif
+};
+
 //------------------------------------------------------------------------------
 //
 QENTNDArrayData::QENTNDArrayData ()
@@ -121,9 +161,10 @@ void QENTNDArrayData::assignOther (const QENTNDArrayData& other)
    this->uniqueId = other.uniqueId;
    this->descriptor = other.descriptor;
 
-   this->attributeMap = other.attributeMap;
+   this->attributeCache = other.attributeCache;
 
    this->data = other.data;
+   this->dataOwner = other.dataOwner;
    this->codecName = other.codecName;
    this->format = other.format;
    this->bitDepth = other.bitDepth;
@@ -140,7 +181,7 @@ namespace pvd = epics::pvData;
 // based on ntndArrayConverter out of areaDetector.
 //
 template <typename pvAttrType, typename valueType>
-static void toAttribute (QENTNDArrayData::AttributeMaps map, pvd::PVStructurePtr src)
+static void toAttribute (QENTNDArrayData::AttributeMaps& map, pvd::PVStructurePtr src)
 {
     const char* name   = src->getSubField<pvd::PVString>("name")->get().c_str();
 //  const char* desc   = src->getSubField<pvd::PVString>("descriptor")->get().c_str();
@@ -148,7 +189,7 @@ static void toAttribute (QENTNDArrayData::AttributeMaps map, pvd::PVStructurePtr
     map.insert (QString (name), QVariant (value));
 }
 
-static void toStringAttribute (QENTNDArrayData::AttributeMaps map, pvd::PVStructurePtr src)
+static void toStringAttribute (QENTNDArrayData::AttributeMaps& map, pvd::PVStructurePtr src)
 {
     const char* name   = src->getSubField<pvd::PVString>("name")->get().c_str();
 //  const char* desc   = src->getSubField<pvd::PVString>("descriptor")->get().c_str();
@@ -156,6 +197,12 @@ static void toStringAttribute (QENTNDArrayData::AttributeMaps map, pvd::PVStruct
     map.insert (QString (name), QVariant (value));
 }
 
+static bool isColorMode (const pvd::PVStructurePtr& src)
+{
+   pvd::PVStringPtr name (src->getSubField<pvd::PVString>("name"));
+   return name && (name->get() == "ColorMode");
+}
+
 
 // Format/structure
 // epics:nt/NTNDArray:1.0
@@ -308,37 +355,14 @@ bool QENTNDArrayData::assignFrom (epics::nt::NTNDArray::const_shared_pointer ite
    pvd::PVStringPtr desc = item->getDescriptor();
    this->descriptor = QString::fromStdString (desc->getAs <std::string>());
 
-   // process attributeList - based on ntndArrayConverter out of areaDetector.
+   // process attributeList - the attributes themselves are parsed on demand.
    //
-   this->attributeMap.clear();
    pvd::PVStructureArray::const_svector attrVec (item->getAttribute()->view());
-
-   for (VectorIter it = attrVec.cbegin(); it != attrVec.cend(); ++it) {
-      pvd::PVScalarPtr srcScalar((*it)->getSubField<pvd::PVUnion>("value")->get<pvd::PVScalar>());
-
-      if (srcScalar) {
-         switch (srcScalar->getScalar()->getScalarType()) {
-            case pvd::pvByte:   toAttribute<pvd::PVByte,   int8_t>  (this->attributeMap, *it); break;
-            case pvd::pvUByte:  toAttribute<pvd::PVUByte,  uint8_t> (this->attributeMap, *it); break;
-            case pvd::pvShort:  toAttribute<pvd::PVShort,  int16_t> (this->attributeMap, *it); break;
-            case pvd::pvUShort: toAttribute<pvd::PVUShort, uint16_t>(this->attributeMap, *it); break;
-            case pvd::pvInt:    toAttribute<pvd::PVInt,    int32_t> (this->attributeMap, *it); break;
-            case pvd::pvUInt:   toAttribute<pvd::PVUInt,   uint32_t>(this->attributeMap, *it); break;
-            case pvd::pvFloat:  toAttribute<pvd::PVFloat,  float>   (this->attributeMap, *it); break;
-            case pvd::pvDouble: toAttribute<pvd::PVDouble, double>  (this->attributeMap, *it); break;
-            case pvd::pvString: toStringAttribute                   (this->attributeMap, *it); break;
-            case pvd::pvBoolean:
-            case pvd::pvLong:
-            case pvd::pvULong:
-            default:
-               break;   // ignore invalid types
-         }
-      }
-   }
+   this->attributeCache = QENTNDArrayData::findAttributeCache (attrVec);
 
    // Do a special for the ColorMode attribute.
    //
-   this->format = this->getImageFormat (attrVec);
+   this->format = this->attributeCache->format;
 
    return true;
 
@@ -364,43 +388,128 @@ pvd::ScalarType QENTNDArrayData::getValueType (pvd::PVUnionPtr value) const
 }
 
 // writes to QByteArray data
+// The pvData value array is a frozen, i.e. immutable, shared vector. Rather than
+// copy the image data, we hold a reference to the vector and wrap its memory.
+//
 template <typename arrayType>
 void QENTNDArrayData::toValue (pvd::PVUnionPtr value)
 {
    typedef typename arrayType::value_type arrayValType;
    typedef typename arrayType::const_svector arrayVecType;
 
-   arrayVecType srcVec (value->get<arrayType>()->view());
+   QSharedPointer<arrayVecType> holder (new arrayVecType (value->get<arrayType>()->view()));
 
-   const int length = (int) srcVec.size() * (int) sizeof(arrayValType);
-   this->data.clear();
-   this->data.append ((const char *)srcVec.data(), length);
+   const int length = (int) holder->size() * (int) sizeof(arrayValType);
+   this->data = QByteArray::fromRawData ((const char *)holder->data(), length);
+   this->dataOwner = holder;
 }
 
 
 //------------------------------------------------------------------------------
 //
 QE::ImageFormatOptions QENTNDArrayData::getImageFormat
-   (pvd::PVStructureArray::const_svector attrs) const
+   (const pvd::PVStructureArray::const_svector& attrs)
 {
+   // Index of the ColorMode attribute in the last attribute array. The set of
+   // attributes seldom changes, so check there first.
+   //
+   static QAtomicInt colorModeIndexHint (-1);
+
    QE::ImageFormatOptions result = QE::Mono;
 
-   for (VectorIter it (attrs.cbegin()); it != attrs.cend (); ++it) {
-       const std::string name = (*it)->getSubField<pvd::PVString>("name")->get();
-       if (name == "ColorMode") {
-           pvd::PVUnionPtr field ((*it)->getSubField<pvd::PVUnion>("value"));
-           int cm = TR1::static_pointer_cast<pvd::PVInt> (field->get())->get();
-           if ((cm >= 0) && (cm < QE::numberOfImageFormats)) {
-              // Is casting ok - maybe we need a look up table.
-              //
-              result = QE::ImageFormatOptions (cm);
-           }
-           break;
-       }
+   const int count = (int) attrs.size();
+   int index = colorModeIndexHint.loadAcquire ();
+   if ((index < 0) || (index >= count) || !isColorMode (attrs [index])) {
+      index = -1;
+      for (int j = 0; j < count; j++) {
+         if (isColorMode (attrs [j])) {
+            index = j;
+            break;
+         }
+      }
+      if (index < 0) return result;  // not found
+      colorModeIndexHint.storeRelease (index);
+   }
+
+   pvd::PVUnionPtr field (attrs [index]->getSubField<pvd::PVUnion>("value"));
+   pvd::PVScalarPtr scalar (field ? field->get<pvd::PVScalar>() : pvd::PVScalarPtr ());
+   if (scalar) {
+      const int cm = scalar->getAs<pvd::int32>();
+      if ((cm >= 0) && (cm < QE::numberOfImageFormats)) {
+         // Is casting ok - maybe we need a look up table.
+         //
+         result = QE::ImageFormatOptions (cm);
+      }
    }
    return result;
 }
 
+//------------------------------------------------------------------------------
+// static
+QENTNDArrayData::AttributeCacheRef QENTNDArrayData::findAttributeCache
+   (const pvd::PVStructureArray::const_svector& attrVec)
+{
+   static QMutex mutex;
+   static QList<AttributeCacheRef> recentCaches;   // least recently used first
+
+   QMutexLocker locker (&mutex);
+
+   // Each cache holds a reference to its attribute array, so that memory cannot
+   // be re-used while cached, hence the same data pointer means the same array.
+   //
+   for (int j = 0; j < recentCaches.count(); j++) {
+      if ((recentCaches [j]->attributes.data() == attrVec.data()) &&
+          (recentCaches [j]->attributes.size() == attrVec.size())) {
+         AttributeCacheRef result = recentCaches.takeAt (j);
+         recentCaches.append (result);
+         return result;
+      }
+   }
+
+   AttributeCacheRef result (new AttributeCache ());
+   result->attributes = attrVec;
+   result->format = QENTNDArrayData::getImageFormat (attrVec);
+
+   if (recentCaches.count() >= MAXIMUM_ATTRIBUTE_CACHES) {
+      recentCaches.removeFirst ();
+   }
+   recentCaches.append (result);
+   return result;
+}
+
+//------------------------------------------------------------------------------
+// based on ntndArrayConverter out of areaDetector.
+//
+void QENTNDArrayData::AttributeCache::parse ()
+{
+   this->attributeMap.clear();
+
+   for (VectorIter it = this->attributes.cbegin(); it != this->attributes.cend(); ++it) {
+      pvd::PVScalarPtr srcScalar((*it)->getSubField<pvd::PVUnion>("value")->get<pvd::PVScalar>());
+
+      if (srcScalar) {
+         switch (srcScalar->getScalar()->getScalarType()) {
+            case pvd::pvByte:   toAttribute<pvd::PVByte,   int8_t>  (this->attributeMap, *it); break;
+            case pvd::pvUByte:  toAttribute<pvd::PVUByte,  uint8_t> (this->attributeMap, *it); break;
+            case pvd::pvShort:  toAttribute<pvd::PVShort,  int16_t> (this->attributeMap, *it); break;
+            case pvd::pvUShort: toAttribute<pvd::PVUShort, uint16_t>(this->attributeMap, *it); break;
+            case pvd::pvInt:    toAttribute<pvd::PVInt,    int32_t> (this->attributeMap, *it); break;
+            case pvd::pvUInt:   toAttribute<pvd::PVUInt,   uint32_t>(this->attributeMap, *it); break;
+            case pvd::pvFloat:  toAttribute<pvd::PVFloat,  float>   (this->attributeMap, *it); break;
+            case pvd::pvDouble: toAttribute<pvd::PVDouble, double>  (this->attributeMap, *it); break;
+            case pvd::pvString: toStringAttribute                   (this->attributeMap, *it); break;
+            case pvd::pvBoolean:
+            case pvd::pvLong:
+            case pvd::pvULong:
+            default:
+               break;   // ignore invalid types
+         }
+      }
+   }
+
+   this->isParsed = true;
+}
+
 #endif  // QE_INCLUDE_PV_ACCESS
 
 //------------------------------------------------------------------------------
@@ -409,7 +518,8 @@ void QENTNDArrayData::clear ()
 {
    this->isDecompressed = false;
    this->data.clear();
-   this->attributeMap.clear();
+   this->dataOwner.clear();
+   this->attributeCache.clear();
    this->codecName = "";
    this->format = QE::Mono;
    this->bitDepth = 8;
@@ -435,6 +545,19 @@ void QENTNDArrayData::clear ()
 //
 QByteArray QENTNDArrayData::getData () const
 {
+   if (this->dataOwner) {
+      // Raw view onto pvData memory - must deep copy.
+      //
+      return QByteArray (this->data.constData(), this->data.size());
+   }
+   return this->data;
+}
+
+//------------------------------------------------------------------------------
+//
+QByteArray QENTNDArrayData::getDataView (DataOwner& owner) const
+{
+   owner = this->dataOwner;
    return this->data;
 }
 
@@ -511,7 +634,15 @@ int QENTNDArrayData::getBitDepth () const
 QVariant QENTNDArrayData::getAttibute (const QString& name) const
 {
    QVariant result (QVariant::Invalid);
-   result = this->attributeMap.value(name, result);
+   if (!this->attributeCache) return result;
+
+   QMutexLocker locker (&this->attributeCache->mutex);
+#ifdef QE_INCLUDE_PV_ACCESS
+   if (!this->attributeCache->isParsed) {
+      this->attributeCache->parse ();
+   }
+#endif
+   result = this->attributeCache->attributeMap.value(name, result);
    return result;
 }
 
@@ -604,9 +735,9 @@ bool QENTNDArrayData::decompressJpeg ()
    // Copy source (by referance).
    //
    QByteArray input = this->data;
-   unsigned char* inbuffer = (unsigned char*) (input.data());
+   unsigned char* inbuffer = (unsigned char*) (input.constData());   // avoid detach
 
-   QByteArray output = QByteArray (int (this->uncompressedDataSize), 0);
+   QByteArray output = QENTNDArrayData::takeBuffer (int (this->uncompressedDataSize));
 
    jpeg_mem_src (&jpegInfo, inbuffer, this->compressedDataSize);
 
@@ -632,6 +763,8 @@ bool QENTNDArrayData::decompressJpeg ()
    // Copy output back to data (by referance).
    //
    this->data = output;
+   this->dataOwner.clear();
+   QENTNDArrayData::recycleBuffer (output);
 
    return result;
 
@@ -658,16 +791,19 @@ bool QENTNDArrayData::decompressBlosc ()
    // Copy source (by referance).
    //
    QByteArray input = this->data;
-   QByteArray output = QByteArray (int (this->uncompressedDataSize), 0);
+   QByteArray output = QENTNDArrayData::takeBuffer (int (this->uncompressedDataSize));
 
    const size_t destSize = this->uncompressedDataSize;
 
-   status = blosc_decompress_ctx (input.data(), output.data(), destSize, 1);
+   status = blosc_decompress_ctx (input.constData(), output.data(), destSize,
+                                  QENTNDArrayData::bloscThreads ());
    result = (status >= 0);
 
    // Copy output back to data (by ref with copy-on-write).
    //
    this->data = output;
+   this->dataOwner.clear();
+   QENTNDArrayData::recycleBuffer (output);
 
    return result;
 
@@ -694,16 +830,18 @@ bool QENTNDArrayData::decompressLz4 ()
    // Copy source (by referance).
    //
    QByteArray input = this->data;
-   QByteArray output = QByteArray (int (this->uncompressedDataSize), 0);
+   QByteArray output = QENTNDArrayData::takeBuffer (int (this->uncompressedDataSize));
 
    int originalSize = this->uncompressedDataSize;
 
-   status = LZ4_decompress_fast (input.data (), output.data (), originalSize);
+   status = LZ4_decompress_fast (input.constData (), output.data (), originalSize);
    result = (status >= 0);
 
    // Copy output back to data (by ref with copy-on-write).
    //
    this->data = output;
+   this->dataOwner.clear();
+   QENTNDArrayData::recycleBuffer (output);
 
    return result;
 
@@ -730,13 +868,13 @@ bool QENTNDArrayData::decompressBslz4 ()
    // Copy source (by referance).
    //
    QByteArray input = this->data;
-   QByteArray output = QByteArray (int (this->uncompressedDataSize), 0);
+   QByteArray output = QENTNDArrayData::takeBuffer (int (this->uncompressedDataSize));
 
    const size_t numberOfElements = this->uncompressedDataSize;
    const size_t elementSize = 1;  /// ONLY works for mono 8 bit
 
    size_t blockSize = 0;
-   status = bshuf_decompress_lz4 (input.data(), output.data(),
+   status = bshuf_decompress_lz4 (input.constData(), output.data(),
                                   numberOfElements, elementSize,
                                   blockSize);
    result = (status >= 0);
@@ -744,6 +882,8 @@ bool QENTNDArrayData::decompressBslz4 ()
    // Copy output back to data (by ref with copy-on-write).
    //
    this->data = output;
+   this->dataOwner.clear();
+   QENTNDArrayData::recycleBuffer (output);
 
    return result;
 
@@ -753,6 +893,58 @@ bool QENTNDArrayData::decompressBslz4 ()
 #endif
 }
 
+//------------------------------------------------------------------------------
+// static
+QByteArray QENTNDArrayData::takeBuffer (const int size)
+{
+   {
+      QMutexLocker locker (&bufferPoolMutex);
+
+      for (int j = 0; j < bufferPool.count (); j++) {
+         // Note: isDetached means that the pool holds the only reference.
+         //
+         if ((bufferPool [j].size () == size) && bufferPool [j].isDetached ()) {
+            return bufferPool.takeAt (j);
+         }
+      }
+   }
+
+   // None available - allocate a new buffer, no need to zero fill.
+   //
+   QByteArray result;
+   result.resize (size);
+   return result;
+}
+
+//------------------------------------------------------------------------------
+// static
+void QENTNDArrayData::recycleBuffer (const QByteArray& buffer)
+{
+   QMutexLocker locker (&bufferPoolMutex);
+
+   // Discard the oldest buffer when the pool is full.
+   //
+   if (bufferPool.count () >= MAXIMUM_POOLED_BUFFERS) {
+      bufferPool.removeFirst ();
+   }
+   bufferPool.append (buffer);
+}
+
+//------------------------------------------------------------------------------
+// static
+static int readBloscThreads ()
+{
+   QEAdaptationParameters ap ("QE_");
+   const int defaultNumber = MIN (4, QThread::idealThreadCount ());
+   return LIMIT (ap.getInt ("blosc_threads", defaultNumber), 1, 64);
+}
+
+int QENTNDArrayData::bloscThreads ()
+{
+   static const int number = readBloscThreads ();   // thread safe initialisation
+   return number;
+}
+
 //------------------------------------------------------------------------------
 // static
 bool QENTNDArrayData::isAssignableVariant (const QVariant & item)
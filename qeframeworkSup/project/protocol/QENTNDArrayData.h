@@ -34,6 +34,7 @@
 #include <QString>
 #include <QStringList>
 #include <QMap>
+#include <QSharedPointer>
 #include <QVariant>
 #include <QEEnums.h>
 #include <QEFrameworkLibraryGlobal.h>
@@ -84,8 +85,24 @@ public:
    //
    bool decompressData ();
 
+   // Returns the image data. The returned byte array is independent of this
+   // object and may be retained indefinitely.
+   //
    QByteArray getData () const;
 
+   // Holds the memory underlying the image data when that memory is owned by
+   // the pvData structure rather than by a QByteArray, i.e. uncompressed images.
+   //
+   typedef QSharedPointer<void> DataOwner;
+
+   // Zero copy alternative to getData. When the image data is still held by the
+   // pvData structure, the returned byte array references that memory directly
+   // and the owner is set accordingly, otherwise the owner is set null.
+   // Any shallow copy of the returned byte array must be accompanied by a copy
+   // of the owner for as long as the copy may be referenced.
+   //
+   QByteArray getDataView (DataOwner& owner) const;
+
    // Returns the name of the codec used to compress image.
    // If image was not compressed, this function returns an empty string.
    //
@@ -101,6 +118,8 @@ public:
    int getBitDepth () const;
 
    // Returns QVariant type Invalid is the attribute is not defined.
+   // Attributes are parsed on first access only, and the parsed attributes are
+   // shared by all copies of this object.
    //
    QVariant getAttibute (const QString& name) const;
 
@@ -130,6 +149,12 @@ public:
 
 private:
 
+   // Holds the (unparsed) attributes and the attribute map, which is populated
+   // on demand. Defined in the cpp file.
+   //
+   class AttributeCache;
+   typedef QSharedPointer<AttributeCache> AttributeCacheRef;
+
 #ifdef QE_INCLUDE_PV_ACCESS
    // array iterator
    //
@@ -142,9 +167,15 @@ private:
    template <typename arrayType>
    void toValue (epics::pvData::PVUnionPtr value);
 
-   QE::ImageFormatOptions getImageFormat
-      (epics::pvData::PVStructureArray::const_svector attrVec) const;
+   static QE::ImageFormatOptions getImageFormat
+      (const epics::pvData::PVStructureArray::const_svector& attrVec);
 
+   // Returns the attribute cache for the given attribute array. If the array is
+   // the same as that of a recent frame, i.e. unchanged by the server, then that
+   // frame's cache, together with any attributes already parsed, is re-used.
+   //
+   static AttributeCacheRef findAttributeCache
+      (const epics::pvData::PVStructureArray::const_svector& attrVec);
 #endif
 
    void assignOther (const QENTNDArrayData& other);
@@ -154,6 +185,19 @@ private:
    bool decompressLz4 ();
    bool decompressBslz4 ();
 
+   // Decompression output buffers are recycled. takeBuffer returns a buffer of
+   // the required size that is not referenced elsewhere, re-using the storage of
+   // a previous frame of the same size if available. Once written, the buffer is
+   // passed to recycleBuffer, which retains a (shallow) copy so that the storage
+   // may be re-used once all other references to it have been released.
+   //
+   static QByteArray takeBuffer (const int size);
+   static void recycleBuffer (const QByteArray& buffer);
+
+   // Number of threads used by blosc - from the QE_BLOSC_THREADS adaptation parameter.
+   //
+   static int bloscThreads ();
+
    int numberDimensions;
    int dimensionSizes [10];   // we expect only 2 or 3. area detector NDArray allows upto 10
    int bytesPerPixel;
@@ -171,9 +215,10 @@ private:
    int uniqueId;
    QString descriptor;
 
-   AttributeMaps attributeMap;
+   AttributeCacheRef attributeCache;
 
    QByteArray data;                 // basic image data
+   DataOwner dataOwner;             // set when data is a raw view onto pvData memory
    QString codecName;               // the codec nam
    QE::ImageFormatOptions format;   // derived from the ColorMode attribute
    int bitDepth;
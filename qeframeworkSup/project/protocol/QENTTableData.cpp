@@ -26,6 +26,8 @@
 
 #include "QENTTableData.h"
 #include <iostream>
+#include <string>
+#include <QECommon.h>
 #include <QEPvaData.h>
 
 #define DEBUG qDebug() << "QENTTableData" << __LINE__ << __FUNCTION__ << "  "
@@ -36,6 +38,7 @@
 QENTTableData::QENTTableData ()
 {
    // needed for types to be registrered as meta type.
+   this->rowCount = 0;
 }
 
 //------------------------------------------------------------------------------
@@ -43,8 +46,6 @@ QENTTableData::QENTTableData ()
 QENTTableData::QENTTableData (const QENTTableData & other)
 {
    // needed for types to be registrered as meta type.
-   this->labels = other.labels;
-   this->data = other.data;
    *this = other;
 }
 
@@ -56,11 +57,13 @@ QENTTableData::~QENTTableData ()
 }
 
 //------------------------------------------------------------------------------
+// Columns are shallow copied - the column data are immutable.
 //
 QENTTableData& QENTTableData::operator=(const QENTTableData& other)
 {
    this->labels = other.labels;
-   this->data = other.data;
+   this->columns = other.columns;
+   this->rowCount = other.rowCount;
    return *this;
 }
 
@@ -72,6 +75,29 @@ namespace TR1 = std::tr1;
 namespace pvd = epics::pvData;
 namespace nmt = epics::nt;
 
+Q_STATIC_ASSERT (sizeof (pvd::boolean) == 1);
+
+//------------------------------------------------------------------------------
+// When the pvData element type matches pvet, getAs provides a view of the data
+// as opposed to a copy.
+//
+template <typename pvet>
+void QENTTableData::toColumn (Column& column, const ColumnTypes type,
+                              const pvd::PVScalarArray::const_shared_pointer& scalarArray)
+{
+   typedef pvd::shared_vector<const pvet> VectorType;
+
+   QSharedPointer<VectorType> holder (new VectorType ());
+   scalarArray->getAs (*holder);
+
+   column.type = type;
+   column.count = (int) holder->size ();
+   column.data = holder->data ();
+   column.owner = holder;
+}
+
+//------------------------------------------------------------------------------
+//
 bool QENTTableData::assignFrom (nmt::NTTable::const_shared_pointer table)
 {
    static bool verbose = true;
@@ -90,7 +116,8 @@ bool QENTTableData::assignFrom (nmt::NTTable::const_shared_pointer table)
    // Temp data variables - so that the object is all or nothing.
    //
    QStringList labelsTemp;
-   QList < QVariantList > dataTemp;
+   QList<Column> columnsTemp;
+   int rowCountTemp = 0;
    pvd::shared_vector<const std::string> labelNames;
 
    table->getLabels()->getAs (labelNames);
@@ -124,15 +151,35 @@ bool QENTTableData::assignFrom (nmt::NTTable::const_shared_pointer table)
       pvd::PVScalarArray::const_shared_pointer colDataArray =
             TR1::static_pointer_cast < const pvd::PVScalarArray > (colDataField);
 
-      // MAYBE: The variant could become one of the array vector type variants
-      // defined in QEVariants or a QStringList variant.
-      //
-      const QVariantList colData = QEPvaData::scalarArrayToQVariantList (colDataArray);
-      dataTemp.append (colData);
+      Column column;
+      column.type = ctInvalid;
+      column.count = 0;
+      column.data = NULL;
+
+      switch (colDataArray->getScalarArray ()->getElementType ()) {
+         case pvd::pvBoolean: toColumn<pvd::boolean> (column, ctBool,   colDataArray); break;
+         case pvd::pvByte:    toColumn<int8_t>       (column, ctInt8,   colDataArray); break;
+         case pvd::pvShort:   toColumn<int16_t>      (column, ctInt16,  colDataArray); break;
+         case pvd::pvInt:     toColumn<int32_t>      (column, ctInt32,  colDataArray); break;
+         case pvd::pvLong:    toColumn<int64_t>      (column, ctInt64,  colDataArray); break;
+         case pvd::pvUByte:   toColumn<uint8_t>      (column, ctUint8,  colDataArray); break;
+         case pvd::pvUShort:  toColumn<uint16_t>     (column, ctUint16, colDataArray); break;
+         case pvd::pvUInt:    toColumn<uint32_t>     (column, ctUint32, colDataArray); break;
+         case pvd::pvULong:   toColumn<uint64_t>     (column, ctUint64, colDataArray); break;
+         case pvd::pvFloat:   toColumn<float>        (column, ctFloat,  colDataArray); break;
+         case pvd::pvDouble:  toColumn<double>       (column, ctDouble, colDataArray); break;
+         case pvd::pvString:  toColumn<std::string>  (column, ctString, colDataArray); break;
+         default:
+            break;   // leave as an empty, invalid, column
+      }
+
+      columnsTemp.append (column);
+      rowCountTemp = MAX (rowCountTemp, column.count);
    }
 
    this->labels = labelsTemp;
-   this->data = dataTemp;
+   this->columns = columnsTemp;
+   this->rowCount = rowCountTemp;
 
    return true;
 
@@ -146,7 +193,8 @@ bool QENTTableData::assignFrom (nmt::NTTable::const_shared_pointer table)
 void QENTTableData::clear ()
 {
    this->labels.clear ();
-   this->data.clear ();
+   this->columns.clear ();
+   this->rowCount = 0;
 }
 
 //------------------------------------------------------------------------------
@@ -160,14 +208,7 @@ QStringList QENTTableData::getLabels () const
 //
 int QENTTableData::getRowCount () const
 {
-   int result = 0;
-   for (int j = 0; j < this->data.count (); j++) {
-      int rc = this->data.value (j).count ();
-      if (result < rc) {
-         result = rc;
-      }
-   }
-   return result;
+   return this->rowCount;
 }
 
 //------------------------------------------------------------------------------
@@ -176,7 +217,7 @@ int QENTTableData::getColCount () const
 {
    int result = 0;
    // Based on data, not column lables.
-   result = this->data.count ();
+   result = this->columns.count ();
    return result;
 }
 
@@ -185,16 +226,13 @@ int QENTTableData::getColCount () const
 QVariantList QENTTableData::getRowData (const int row) const
 {
    QVariantList result;
-   QVariant none;
 
    const int nr = this->getRowCount ();
    const int nc = this->getColCount ();
 
    if ((row >= 0) && (row < nr)) {
       for (int col = 0; col < nc; col++) {
-         QVariant item;
-         item = this->data.value (col).value (row, none);
-         result.append (item);
+         result.append (this->getItem (row, col));
       }
    }
    return result;
@@ -205,30 +243,141 @@ QVariantList QENTTableData::getRowData (const int row) const
 QVariantList QENTTableData::getColData (const int col) const
 {
    QVariantList result;
-   if (col >= 0 && col < this->data.count ()) {
-      result = this->data.value (col);
+   if (col >= 0 && col < this->columns.count ()) {
+      const int n = this->columns [col].count;
+      for (int row = 0; row < n; row++) {
+         result.append (this->getItem (row, col));
+      }
    }
    return result;
 }
 
 //------------------------------------------------------------------------------
+// Local macro - element j of column c, interpreted as type t.
 //
+#define ELEMENT(c, t, j)  (((const t*) (c).data) [j])
+
 QVariant QENTTableData::getItem (const int row, const int col) const
 {
-   static const QVariant none;
    QVariant result;
 
-   const int nr = this->getRowCount ();
-   const int nc = this->getColCount ();
+   if ((col < 0) || (col >= this->columns.count ())) return result;
+   const Column& column = this->columns [col];
+   if ((row < 0) || (row >= column.count)) return result;
 
-   if ((row >= 0) && (row < nr)) {
-      if (col >= 0 && col < nc) {
-         result = this->data.value (col).value (row, none);
-      }
+   // Variant types consistent with QEPvaData::scalarArrayToQVariantList.
+   //
+   switch (column.type) {
+      case ctBool:    result = QVariant (bool (ELEMENT (column, uint8_t, row)));   break;
+      case ctInt8:    result = QVariant (int (ELEMENT (column, int8_t, row)));     break;
+      case ctInt16:   result = QVariant (int (ELEMENT (column, int16_t, row)));    break;
+      case ctInt32:   result = QVariant (int (ELEMENT (column, int32_t, row)));    break;
+      case ctInt64:   result = QVariant (qlonglong (ELEMENT (column, int64_t, row)));  break;
+      case ctUint8:   result = QVariant (uint (ELEMENT (column, uint8_t, row)));   break;
+      case ctUint16:  result = QVariant (uint (ELEMENT (column, uint16_t, row)));  break;
+      case ctUint32:  result = QVariant (uint (ELEMENT (column, uint32_t, row)));  break;
+      case ctUint64:  result = QVariant (qulonglong (ELEMENT (column, uint64_t, row))); break;
+      case ctFloat:   result = QVariant (ELEMENT (column, float, row));            break;
+      case ctDouble:  result = QVariant (ELEMENT (column, double, row));           break;
+      case ctString:  result = QVariant (QString::fromStdString (ELEMENT (column, std::string, row))); break;
+      default:
+         break;
    }
    return result;
 }
 
+//------------------------------------------------------------------------------
+//
+QString QENTTableData::getItemText (const int row, const int col) const
+{
+   if ((col < 0) || (col >= this->columns.count ())) return QString ();
+   const Column& column = this->columns [col];
+   if ((row < 0) || (row >= column.count)) return QString ();
+
+   switch (column.type) {
+      case ctString:
+         return QString::fromStdString (ELEMENT (column, std::string, row));
+
+      case ctBool:
+      case ctFloat:
+      case ctDouble:
+         // Let QVariant do the formatting, for consistency.
+         return this->getItem (row, col).toString ();
+
+      case ctInt8:   return QString::number (ELEMENT (column, int8_t, row));
+      case ctInt16:  return QString::number (ELEMENT (column, int16_t, row));
+      case ctInt32:  return QString::number (ELEMENT (column, int32_t, row));
+      case ctInt64:  return QString::number (qlonglong (ELEMENT (column, int64_t, row)));
+      case ctUint8:  return QString::number (ELEMENT (column, uint8_t, row));
+      case ctUint16: return QString::number (ELEMENT (column, uint16_t, row));
+      case ctUint32: return QString::number (ELEMENT (column, uint32_t, row));
+      case ctUint64: return QString::number (qulonglong (ELEMENT (column, uint64_t, row)));
+
+      default:
+         return QString ();
+   }
+}
+
+//------------------------------------------------------------------------------
+//
+double QENTTableData::getFloatingItem (const int row, const int col,
+                                       const double defaultValue) const
+{
+   if ((col < 0) || (col >= this->columns.count ())) return defaultValue;
+   const Column& column = this->columns [col];
+   if ((row < 0) || (row >= column.count)) return defaultValue;
+
+   switch (column.type) {
+      case ctBool:    return ELEMENT (column, uint8_t, row) ? 1.0 : 0.0;
+      case ctInt8:    return ELEMENT (column, int8_t, row);
+      case ctInt16:   return ELEMENT (column, int16_t, row);
+      case ctInt32:   return ELEMENT (column, int32_t, row);
+      case ctInt64:   return double (ELEMENT (column, int64_t, row));
+      case ctUint8:   return ELEMENT (column, uint8_t, row);
+      case ctUint16:  return ELEMENT (column, uint16_t, row);
+      case ctUint32:  return ELEMENT (column, uint32_t, row);
+      case ctUint64:  return double (ELEMENT (column, uint64_t, row));
+      case ctFloat:   return ELEMENT (column, float, row);
+      case ctDouble:  return ELEMENT (column, double, row);
+      default:        return defaultValue;
+   }
+}
+
+#undef ELEMENT
+
+//------------------------------------------------------------------------------
+//
+QENTTableData::ColumnTypes QENTTableData::getColumnType (const int col) const
+{
+   if ((col < 0) || (col >= this->columns.count ())) return ctInvalid;
+   return this->columns [col].type;
+}
+
+//------------------------------------------------------------------------------
+//
+int QENTTableData::getColumnLength (const int col) const
+{
+   if ((col < 0) || (col >= this->columns.count ())) return 0;
+   return this->columns [col].count;
+}
+
+//------------------------------------------------------------------------------
+//
+int QENTTableData::getColumnData (const int col, ColumnTypes& type,
+                                  const void*& data) const
+{
+   if ((col < 0) || (col >= this->columns.count ())) {
+      type = ctInvalid;
+      data = NULL;
+      return 0;
+   }
+
+   const Column& column = this->columns [col];
+   type = column.type;
+   data = column.data;
+   return column.count;
+}
+
 
 //------------------------------------------------------------------------------
 //
@@ -30,6 +30,7 @@
 #include <QDebug>
 #include <QList>
 #include <QMetaType>
+#include <QSharedPointer>
 #include <QString>
 #include <QStringList>
 #include <QVariant>
@@ -54,6 +55,11 @@
 ///   tab = qvariant_cast<QENTTableData>(var);  or
 ///   tab.assignFromVariant (var);
 ///
+/// The table data is held column by column, each column being a typed vector that
+/// shares memory with the pvData structure, i.e. no per element conversion is done
+/// on update. Elements are converted on access, so consumers such as table models
+/// should access individual items as opposed to whole rows or columns.
+///
 class QE_FRAMEWORK_LIBRARY_SHARED_EXPORT QENTTableData {
 public:
    // explicit is a no-no here.
@@ -69,6 +75,24 @@ public:
    bool assignFrom (epics::nt::NTTable::const_shared_pointer item);
 #endif
 
+   // Column element types.
+   //
+   enum ColumnTypes {
+      ctInvalid = 0,
+      ctBool,        // 1 byte, 0 is false
+      ctInt8,
+      ctInt16,
+      ctInt32,
+      ctInt64,
+      ctUint8,
+      ctUint16,
+      ctUint32,
+      ctUint64,
+      ctFloat,
+      ctDouble,
+      ctString       // std::string
+   };
+
    // Clear all table data.
    //
    void clear ();
@@ -81,11 +105,26 @@ public:
    int getColCount () const;         // get number of columns
 
    // Access data as rows, columns or individual element.
+   // Note: getRowData and getColData create a variant per element.
    //
    QVariantList getRowData (const int row) const;
    QVariantList getColData (const int col) const;
    QVariant getItem (const int row, const int col) const;
 
+   // Typed element access. getItemText yields the same text as getItem ().toString ().
+   // getFloatingItem returns defaultValue for string/invalid items.
+   //
+   QString getItemText (const int row, const int col) const;
+   double getFloatingItem (const int row, const int col, const double defaultValue = 0.0) const;
+
+   // Direct column access. Returns the number of elements in the column, sets
+   // type and sets data to point to the first element, e.g. a const double* for
+   // ctDouble. The data remain valid while this object (or a copy) exists.
+   //
+   ColumnTypes getColumnType (const int col) const;
+   int getColumnLength (const int col) const;
+   int getColumnData (const int col, ColumnTypes& type, const void*& data) const;
+
    // Converstion to QVariant
    //
    QVariant toVariant () const;
@@ -106,13 +145,31 @@ public:
    static bool registerMetaType ();
 
 private:
+   // Each column references a typed, immutable, vector of row elements.
+   // The owner keeps that vector alive - typically a pvData shared vector.
+   //
+   struct Column {
+      ColumnTypes type;
+      int count;
+      const void* data;
+      QSharedPointer<void> owner;
+   };
+
    QStringList labels;
 
-   // Table data is a list of column data
-   // Each column is a (variant) list of row elements.
+   // Table data is a list of column data.
    // The data is column major to reflect the epics:nt/NTTable type.
    //
-   QList<QVariantList> data;
+   QList<Column> columns;
+   int rowCount;          // the max of all columns
+
+#ifdef QE_INCLUDE_PV_ACCESS
+   // Sets up column to reference the scalar array data.
+   //
+   template <typename pvet>
+   static void toColumn (Column& column, const ColumnTypes type,
+                         const epics::pvData::PVScalarArray::const_shared_pointer& scalarArray);
+#endif
 };
 
 // allows qDebug() << QETableData object.
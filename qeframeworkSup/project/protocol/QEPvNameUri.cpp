@@ -43,6 +43,7 @@ static const QString prefix[QEPvNameUri::NUMBER_OF_PROTOCOLS] = {
 };
 
 static const QString cds = "://";    // colon double slash
+static const QChar requestSeparator = '?';
 
 
 //------------------------------------------------------------------------------
@@ -113,6 +114,7 @@ QEPvNameUri::Protocol QEPvNameUri::getDefaultProtocol()
 QEPvNameUri::QEPvNameUri ()
 {
    this->pvName = "";
+   this->pvRequest = "";
    this->protocol = QEPvNameUri::undefined;
 }
 
@@ -122,6 +124,7 @@ QEPvNameUri::QEPvNameUri (const QString& pvNameIn,
                           const Protocol protocolIn)
 {
    this->pvName = pvNameIn;
+   this->pvRequest = "";
    this->protocol = protocolIn;
 }
 
@@ -146,6 +149,9 @@ QString QEPvNameUri::encodeUri () const
       case pva:
 #ifdef QE_INCLUDE_PV_ACCESS
          result = QString ("pva%1%2").arg (cds).arg (this->pvName);
+         if (!this->pvRequest.isEmpty ()) {
+            result.append (requestSeparator).append (this->pvRequest);
+         }
 #endif
          break;
 
@@ -214,6 +220,17 @@ bool QEPvNameUri::decodeUri (const QString& uri, const bool strict)
       pvName = work;
    }
 
+   // Split off any pv request - pva only.
+   //
+   QString pvRequest = "";
+   if (specifiedProtocol == QEPvNameUri::pva) {
+      const int kr = pvName.indexOf (requestSeparator);
+      if (kr >= 0) {
+         pvRequest = pvName.mid (kr + 1).trimmed ();
+         pvName = pvName.left (kr);
+      }
+   }
+
    pvName = pvName.trimmed ();
    if (pvName.isEmpty ()) {
       return false;
@@ -221,6 +238,7 @@ bool QEPvNameUri::decodeUri (const QString& uri, const bool strict)
 
    this->protocol = specifiedProtocol;
    this->pvName = pvName;
+   this->pvRequest = pvRequest;
 
    return true;
 }
@@ -253,6 +271,20 @@ QString QEPvNameUri::getPvName () const
    return this->pvName;
 }
 
+//------------------------------------------------------------------------------
+//
+void QEPvNameUri::setPvRequest (const QString& pvRequestIn)
+{
+   this->pvRequest = pvRequestIn.trimmed ();
+}
+
+//------------------------------------------------------------------------------
+//
+QString QEPvNameUri::getPvRequest () const
+{
+   return this->pvRequest;
+}
+
 
 //==============================================================================
 // QEPvNameUriList
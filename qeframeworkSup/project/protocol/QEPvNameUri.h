@@ -46,6 +46,14 @@
 /// the environment variable QE_DEFAULT_PROVIDER, and can be defined as either "CA"
 /// or "PVA" - case insensitive.  If the environment variable is not defined or is
 /// ill-defined the default default provider is Channel Access.
+///
+/// For PV Access only, the PV name may be followed by a '?' and a pvRequest that
+/// is used for get and monitor requests, for example:
+///
+/// "pva://SR11BCM01:CURRENT_MONITOR?field(value,alarm,timeStamp)"
+/// "pva://SR11BCM01:IMAGE?record[queueSize=4,pipeline=true]field()"
+///
+/// When not specified, the whole structure is requested.
 //
 // Rationale:
 // 1) We have extended the framework to handle PV Access, and
@@ -114,10 +122,14 @@ public:
    void setPvName (const QString& pvName);      // set pv name part of uri
    QString getPvName () const;                  // get pv name part of uri
 
+   void setPvRequest (const QString& pvRequest);   // set pva request part of uri
+   QString getPvRequest () const;                  // get pva request part of uri
+
 private:
    static Protocol getDefaultProtocol();        // uses an adaptation parameter
    Protocol protocol;
    QString pvName;
+   QString pvRequest;     // pva only, empty when not specified
 };
 
 
@@ -31,7 +31,11 @@
 #include <QApplication>
 #include <QDebug>
 #include <QQueue>
-#include <QMutex>
+#include <QSharedPointer>
+#include <QAtomicPointer>
+#include <QVector>
+#include <QRunnable>
+#include <QThreadPool>
 
 #include <epicsTime.h>
 #include <QEPvNameUri.h>
@@ -39,8 +43,11 @@
 #include <pv/pvAccess.h>
 #include <pv/pvData.h>
 #include <pv/clientFactory.h>
-#include <QEThreadSafeQueue.h>
+#include <QECommon.h>
+#include <QELockFreeQueue.h>
 #include <QEVectorVariants.h>
+#include <QENTNDArrayData.h>
+#include <QEAdaptationParameters.h>
 
 #define DEBUG qDebug () << "QEPvaClient" << __LINE__ << __FUNCTION__ << "  "
 
@@ -68,8 +75,10 @@ public:
    inline uint64_t uniqueId () const         { return this->theUniqueId; }
 
 private:
+   // Not const so that references may be re-assigned, e.g. pooled updates.
+   //
    const QEPvaClient* theClient;
-   const uint64_t theUniqueId;
+   uint64_t theUniqueId;
 };
 
 //------------------------------------------------------------------------------
@@ -96,9 +105,10 @@ QEPvaClient* QEPvaClientReference::getReference () const
 // Value data is held as a variant. Other support data, e.g. timestamp is
 // held as a basic QEPvaData::TimeStamp class.
 //
-// This data is placed on an queue by the PVA callback threads (via overloaded
-// virtual functions). And taken off the queue by the QEPvaClient running in the
-// main application thread (as this thread only is allowed to update the widgets).
+// This data is posted to the client's update slot by the PVA callback threads
+// (via overloaded virtual functions). And taken off the slot by the QEPvaClient
+// running in the main application thread (as this thread only is allowed to
+// update the widgets).
 //
 // Non Qt threads can't send signals. Potentially we could have placed the update
 // on the event queue for the main thread.
@@ -110,18 +120,44 @@ public:
       ukData
    };
 
-   explicit Update (const QEPvaClientReference& clientReference,
-                    const QString id,
-                    const UpdateKind kind,
-                    const QVariant& pvData,
-                    const QString& pvType,
-                    const bool isConnected);
-   ~Update ();
+   // Meta data presence flags - bit significant.
+   // Meta data is only extracted when the monitor reports it has changed.
+   //
+   enum MetaData {
+      mdNone        = 0x00,
+      mdEnumeration = 0x01,
+      mdAlarm       = 0x02,
+      mdTimeStamp   = 0x04,
+      mdControl     = 0x08,
+      mdDisplay     = 0x10,
+      mdValueAlarm  = 0x20,
+      mdAll         = 0x3F
+   };
+
+   // Updates are recycled via a pool. Use allocate and release rather than
+   // new and delete. Both may be called from any thread.
+   //
+   static Update* allocate (const QEPvaClientReference& clientReference,
+                            const QString& id,
+                            const UpdateKind kind,
+                            const QVariant& pvData,
+                            const QString& pvType,
+                            const bool isConnected);
+   static void release (Update* update);
+
+   // Delete all pooled updates.
+   //
+   static void clearPool ();
 
    // process this update - intended to be called within the main Qt thread.
    //
    void process ();
 
+   // Any meta data present in older but not in this update is copied from older.
+   // Used when this update supersedes older.
+   //
+   void merge (const Update* older);
+
    inline QEPvaClientReference getClientReference () const { return this->clientReference; }
    inline QString getId () const                { return this->id; }
    inline UpdateKind getKind () const           { return this->kind; }
@@ -132,6 +168,12 @@ public:
    inline QString getPvType () const            { return this->pvType; }
    inline bool getIsConnected () const          { return this->isConnected; }
 
+   // Allows the value to be replaced, e.g. by its decompressed form.
+   //
+   inline void setPvData (const QVariant& pvDataIn) { this->pvData = pvDataIn; }
+
+   int metaDataPresent;   // set of MetaData flags
+
    QEPvaData::Enumerated enumeration;
    QEPvaData::Alarm alarm;
    QEPvaData::TimeStamp timeStamp;
@@ -140,34 +182,124 @@ public:
    QEPvaData::ValueAlarm valueAlarm;
 
 private:
-   const QEPvaClientReference clientReference;
-   const QString id;
-   const UpdateKind kind;
-   const QVariant pvData;
-   const QString pvType;
-   const bool isConnected;
+   explicit Update ();
+   ~Update ();
+
+   QEPvaClientReference clientReference;
+   QString id;
+   UpdateKind kind;
+   QVariant pvData;
+   QString pvType;
+   bool isConnected;
+
+   // Used by the update slot.
+   //
+   Update* next;        // list linkage
+   Update* preceding;   // data update pending when the connection state changed
+   int epoch;           // slot epoch when posted
+
+   friend class QEPvaClient::UpdateSlot;
 };
 
 //------------------------------------------------------------------------------
+// Pool of recycled updates. Typically the main thread releases and the
+// pvAccess threads allocate; the queue is used as a multi-consumer free list.
 //
-QEPvaClient::Update::Update (const QEPvaClientReference& clientReferenceIn,
-                             const QString idIn,
-                             const UpdateKind kindIn,
-                             const QVariant& pvDataIn,
-                             const QString& pvTypeIn,
-                             const bool isConnectedIn) :
-   clientReference (clientReferenceIn),
-   id (idIn),
-   kind (kindIn),
-   pvData (pvDataIn),
-   pvType (pvTypeIn),
-   isConnected (isConnectedIn)
+#define UPDATE_POOL_CAPACITY   4096
+
+static QELockFreeQueue<QEPvaClient::Update*> pvaClientUpdatePool (UPDATE_POOL_CAPACITY);
+
+//------------------------------------------------------------------------------
+//
+QEPvaClient::Update::Update () :
+   metaDataPresent (mdNone),
+   clientReference (NULL, 0),
+   kind (ukConnection),
+   isConnected (false),
+   next (NULL),
+   preceding (NULL),
+   epoch (0)
 { }
 
 //------------------------------------------------------------------------------
 //
 QEPvaClient::Update::~Update () { }
 
+//------------------------------------------------------------------------------
+// static
+QEPvaClient::Update* QEPvaClient::Update::allocate (const QEPvaClientReference& clientReferenceIn,
+                                                    const QString& idIn,
+                                                    const UpdateKind kindIn,
+                                                    const QVariant& pvDataIn,
+                                                    const QString& pvTypeIn,
+                                                    const bool isConnectedIn)
+{
+   QEPvaClient::Update* update = NULL;
+   if (!pvaClientUpdatePool.dequeueConcurrent (update) || !update) {
+      update = new QEPvaClient::Update ();
+   }
+
+   update->clientReference = clientReferenceIn;
+   update->id = idIn;
+   update->kind = kindIn;
+   update->pvData = pvDataIn;
+   update->pvType = pvTypeIn;
+   update->isConnected = isConnectedIn;
+   update->metaDataPresent = mdNone;
+   update->next = NULL;
+   update->preceding = NULL;
+   update->epoch = 0;
+   return update;
+}
+
+//------------------------------------------------------------------------------
+// static
+void QEPvaClient::Update::release (Update* update)
+{
+   if (!update) return;
+
+   // Don't hold on to (potentially large) data while in the pool.
+   //
+   update->pvData.clear ();
+   update->metaDataPresent = mdNone;
+
+   if (!pvaClientUpdatePool.enqueue (update)) {
+      delete update;   // pool is full
+   }
+}
+
+//------------------------------------------------------------------------------
+// static
+void QEPvaClient::Update::clearPool ()
+{
+   QEPvaClient::Update* update = NULL;
+   while (pvaClientUpdatePool.dequeueConcurrent (update)) {
+      delete update;
+   }
+}
+
+//------------------------------------------------------------------------------
+//
+void QEPvaClient::Update::merge (const Update* older)
+{
+   if (!older) return;
+
+#define MERGE_META_DATA(flag, member)                                \
+   if (!(this->metaDataPresent & flag) && (older->metaDataPresent & flag)) { \
+      this->member.assign (older->member);                             \
+      this->metaDataPresent |= flag;                                   \
+   }
+
+   MERGE_META_DATA (mdEnumeration, enumeration);
+   MERGE_META_DATA (mdAlarm,       alarm);
+   MERGE_META_DATA (mdTimeStamp,   timeStamp);
+   MERGE_META_DATA (mdControl,     control);
+   MERGE_META_DATA (mdDisplay,     display);
+   MERGE_META_DATA (mdValueAlarm,  valueAlarm);
+
+#undef MERGE_META_DATA
+}
+
 //------------------------------------------------------------------------------
 //
 void QEPvaClient::Update::process()
@@ -183,8 +315,445 @@ void QEPvaClient::Update::process()
 }
 
 //==============================================================================
+// QEPvaClient::UpdateSlot
+//==============================================================================
+// Updates from the pvAccess threads to the main thread.
+//
+// Each client has an update slot, shared by the client, its requester interfaces
+// and any in-flight decode jobs. The slot holds the client's pending updates, and
+// it is the slot, rather than each update, that is placed on the update queue.
+// A slot is on the queue at most once, so the queue holds at most one entry per
+// client. No locks are used: the producers (pvAccess and decode threads) and the
+// consumer (main thread) only perform atomic operations on the slot, and no
+// producer ever waits for the main thread.
+//
+// Data updates are coalesced: the slot only holds the latest data update.
+// Meta data is only extracted when it changes, so when a data update is
+// superseded or discarded (e.g. a skipped NTNDArray frame) its meta data is
+// carried over to the client's next data update.
+//
+// Connection updates are held in order on a separate list, each together with
+// the data update that was pending when the connection state changed, which is
+// processed first. Each connection update increments the slot's epoch, and each
+// data update records the epoch when posted, so that a data update is never
+// processed ahead of a connection update that preceded it.
+//
+// When the queue is full, slots are placed on a lock free overflow list instead.
+// No update is discarded other than by coalescing.
+//
+class QEPvaClient::UpdateSlot :
+      public QEnableSharedFromThis<QEPvaClient::UpdateSlot>
+{
+public:
+   explicit UpdateSlot ();
+   ~UpdateSlot ();
+
+   // Producer functions - may be called from any thread.
+   //
+   void postData (Update* item);         // supersedes any pending data update
+   void postConnection (Update* item);
+   void discardData (Update* item);      // any meta data is carried over
+
+   // Returns the number of connection updates posted so far.
+   //
+   inline int getEpoch () const { return this->epoch.loadAcquire (); }
+
+   // Decode job sequence numbers - see QEPvaDecodeJob.
+   //
+   QAtomicInteger<quint32> decodeSubmitted;
+   QAtomicInteger<quint32> decodeDelivered;
+
+   // Consumer functions - main thread only.
+   // Process all queued slots / discard all queued slots.
+   //
+   static void processQueued ();
+   static void clearQueued ();
+
+private:
+   void schedule ();
+   void process ();
+   void mergeCarry (Update* item);
+
+   static void push (QAtomicPointer<Update>& list, Update* item);
+   static void releaseList (Update* list);
+   static void deliver (Update* item);
+
+   QAtomicPointer<Update> data;          // latest data update
+   QAtomicPointer<Update> carry;         // meta data of discarded updates, newest first
+   QAtomicPointer<Update> connections;   // connection updates, newest first
+   QAtomicInt epoch;                     // number of connection updates posted
+   int processedEpoch;                   // number of connection updates processed
+   QAtomicInt isQueued;                  // on the queue or on the overflow list
+
+   // Overflow list linkage.
+   //
+   UpdateSlot* overflowNext;
+   QSharedPointer<UpdateSlot> overflowHold;
+};
+
+#define UPDATE_QUEUE_CAPACITY   16384
+#define UPDATE_BATCH_SIZE       256
+
+typedef QSharedPointer<QEPvaClient::UpdateSlot> UpdateSlotRef;
+
+static QELockFreeQueue<UpdateSlotRef> pvaClientUpdateQueue
+      (UPDATE_QUEUE_CAPACITY, QELockFreeQueue<UpdateSlotRef>::opReject);
+
+static QAtomicPointer<QEPvaClient::UpdateSlot> pvaOverflowList;   // newest first
+static QAtomicInt pvaOverflowDepth;
+static QAtomicInt pvaOverflowCount;
+static QAtomicInt pvaCoalescedCount;
+
+//------------------------------------------------------------------------------
+//
+QEPvaClient::UpdateSlot::UpdateSlot () :
+   decodeSubmitted (0),
+   decodeDelivered (0),
+   data (NULL),
+   carry (NULL),
+   connections (NULL),
+   epoch (0),
+   processedEpoch (0),
+   isQueued (0),
+   overflowNext (NULL)
+{ }
+
+//------------------------------------------------------------------------------
+//
+QEPvaClient::UpdateSlot::~UpdateSlot ()
+{
+   Update::release (this->data.fetchAndStoreAcquire (NULL));
+   releaseList (this->carry.fetchAndStoreAcquire (NULL));
+   releaseList (this->connections.fetchAndStoreAcquire (NULL));
+}
+
+//------------------------------------------------------------------------------
+// static
+void QEPvaClient::UpdateSlot::push (QAtomicPointer<Update>& list, Update* item)
+{
+   // Push only, and the consumer takes the whole list, so no ABA issue.
+   //
+   while (true) {
+      Update* head = list.loadAcquire ();
+      item->next = head;
+      if (list.testAndSetRelease (head, item)) break;
+   }
+}
+
+//------------------------------------------------------------------------------
+// static
+void QEPvaClient::UpdateSlot::releaseList (Update* list)
+{
+   while (list) {
+      Update* next = list->next;
+      Update::release (list->preceding);
+      Update::release (list);
+      list = next;
+   }
+}
+
+//------------------------------------------------------------------------------
+// static
+void QEPvaClient::UpdateSlot::deliver (Update* item)
+{
+   item->process ();
+   Update::release (item);
+}
+
+//------------------------------------------------------------------------------
+//
+void QEPvaClient::UpdateSlot::mergeCarry (Update* item)
+{
+   Update* older = this->carry.fetchAndStoreAcquire (NULL);
+   while (older) {
+      Update* next = older->next;
+      item->merge (older);
+      Update::release (older);
+      older = next;
+   }
+}
+
+//------------------------------------------------------------------------------
+//
+void QEPvaClient::UpdateSlot::postData (Update* item)
+{
+   item->epoch = this->epoch.loadAcquire ();
+   Update* older = this->data.fetchAndStoreOrdered (item);
+   if (older) {
+      pvaCoalescedCount.ref ();
+      this->discardData (older);
+   }
+   this->schedule ();
+}
+
+//------------------------------------------------------------------------------
+//
+void QEPvaClient::UpdateSlot::postConnection (Update* item)
+{
+   // Increment the epoch before taking the pending data update, so that any
+   // data update we do not take is not processed ahead of this update.
+   // This also discards any frames still being decoded.
+   //
+   this->epoch.fetchAndAddOrdered (1);
+
+   Update* pending = this->data.fetchAndStoreOrdered (NULL);
+   if (pending) {
+      this->mergeCarry (pending);
+   } else {
+      releaseList (this->carry.fetchAndStoreAcquire (NULL));
+   }
+   item->preceding = pending;
+
+   push (this->connections, item);
+   this->schedule ();
+}
+
+//------------------------------------------------------------------------------
+//
+void QEPvaClient::UpdateSlot::discardData (Update* item)
+{
+   if (item->metaDataPresent == Update::mdNone) {
+      Update::release (item);
+      return;
+   }
+
+   item->setPvData (QVariant ());   // don't hold on to the value
+
+   // Fold in any already carried meta data, which keeps the carry list short.
+   //
+   this->mergeCarry (item);
+   push (this->carry, item);
+}
+
+//------------------------------------------------------------------------------
+//
+void QEPvaClient::UpdateSlot::schedule ()
+{
+   if (!this->isQueued.testAndSetOrdered (0, 1)) return;   // already scheduled
+
+   UpdateSlotRef self = this->sharedFromThis ();
+   if (pvaClientUpdateQueue.enqueue (self)) return;
+
+   // The queue is full. As we own the queued state, nobody else is
+   // modifying the overflow linkage.
+   //
+   this->overflowHold = self;
+   pvaOverflowCount.ref ();
+   pvaOverflowDepth.ref ();
+   while (true) {
+      UpdateSlot* head = pvaOverflowList.loadAcquire ();
+      this->overflowNext = head;
+      if (pvaOverflowList.testAndSetRelease (head, this)) break;
+   }
+}
+
+//------------------------------------------------------------------------------
+//
+void QEPvaClient::UpdateSlot::process ()
+{
+   // Clear first, so that any update posted from now on reschedules the slot.
+   //
+   this->isQueued.storeRelease (0);
+
+   // Connection updates in posted order, each preceded by the data update
+   // that was pending at the time.
+   //
+   Update* list = this->connections.fetchAndStoreAcquire (NULL);
+   Update* ordered = NULL;
+   while (list) {
+      Update* next = list->next;
+      list->next = ordered;
+      ordered = list;
+      list = next;
+   }
+
+   while (ordered) {
+      Update* next = ordered->next;
+      if (ordered->preceding) {
+         deliver (ordered->preceding);
+         ordered->preceding = NULL;
+      }
+      deliver (ordered);
+      this->processedEpoch++;
+      ordered = next;
+   }
+
+   Update* item = this->data.fetchAndStoreAcquire (NULL);
+   if (!item) return;
+
+   if (item->epoch > this->processedEpoch) {
+      // Posted after a connection update not yet on the list. That update
+      // reschedules this slot, so put the data back unless superseded.
+      //
+      if (!this->data.testAndSetOrdered (NULL, item)) {
+         this->discardData (item);
+      }
+      return;
+   }
+
+   this->mergeCarry (item);
+   deliver (item);
+}
+
+//------------------------------------------------------------------------------
+// static
+void QEPvaClient::UpdateSlot::processQueued ()
+{
+   UpdateSlotRef batch [UPDATE_BATCH_SIZE];
+
+   // Only process the slots queued on entry, so that a steady stream of
+   // updates cannot hold the main thread here indefinitely.
+   //
+   int remaining = pvaClientUpdateQueue.size ();
+   while (remaining > 0) {
+      const int number = pvaClientUpdateQueue.dequeueBatch (batch, MIN (remaining, UPDATE_BATCH_SIZE));
+      if (number <= 0) break;
+      for (int j = 0; j < number; j++) {
+         batch [j]->process ();
+         batch [j].clear ();
+      }
+      remaining -= number;
+   }
+
+   // Now the overflow list, oldest first.
+   //
+   UpdateSlot* list = pvaOverflowList.fetchAndStoreAcquire (NULL);
+   UpdateSlot* ordered = NULL;
+   while (list) {
+      UpdateSlot* next = list->overflowNext;
+      list->overflowNext = ordered;
+      ordered = list;
+      list = next;
+   }
+
+   while (ordered) {
+      // Take the linkage before processing, as the slot may be rescheduled.
+      //
+      UpdateSlot* next = ordered->overflowNext;
+      UpdateSlotRef self = ordered->overflowHold;
+      ordered->overflowHold.clear ();
+      ordered->overflowNext = NULL;
+      pvaOverflowDepth.deref ();
+
+      self->process ();
+      ordered = next;
+   }
+}
+
+//------------------------------------------------------------------------------
+// static
+void QEPvaClient::UpdateSlot::clearQueued ()
+{
+   pvaClientUpdateQueue.clear ();
+
+   UpdateSlot* list = pvaOverflowList.fetchAndStoreAcquire (NULL);
+   while (list) {
+      UpdateSlot* next = list->overflowNext;
+      list->overflowNext = NULL;
+      list->overflowHold.clear ();   // may delete the slot
+      list = next;
+   }
+   pvaOverflowDepth.storeRelease (0);
+}
+
+
+//==============================================================================
+// QEPvaDecodeJob
+//==============================================================================
+// Compressed NTNDArray frames are decompressed by a pool of worker threads
+// before the update is posted to the client's update slot, so that decompression
+// of large frames does not block the main thread.
+// The pool size is set by the QE_PVA_DECODE_THREADS adaptation parameter;
+// zero disables the pool, and decompression reverts to the main thread.
+//
+// Each frame submitted for a client is given a sequence number. A frame that
+// has been superseded by a newer frame for the same client before it has
+// started is skipped; its meta data is carried over to the surviving frame.
+// A frame that has been decompressed is always delivered, unless a newer
+// frame has already been delivered. Frames submitted before a connection
+// change are discarded.
+//
+static QThreadPool* pvaDecodePool = NULL;
+
+class QEPvaDecodeJob : public QRunnable
+{
+public:
+   explicit QEPvaDecodeJob (QEPvaClient::Update* itemIn,
+                            const UpdateSlotRef& slotIn) :
+      item (itemIn),
+      slot (slotIn)
+   {
+      this->epoch = this->slot->getEpoch ();
+      this->sequence = this->slot->decodeSubmitted.fetchAndAddOrdered (1) + 1;
+   }
+
+   ~QEPvaDecodeJob () { }
+
+   void run ();
+
+   // Returns true if the data update needs decompressing.
+   //
+   static bool isRequired (const QVariant& value)
+   {
+      if (!pvaDecodePool) return false;
+      if (!QENTNDArrayData::isAssignableVariant (value)) return false;
+
+      // Note: value.value<> does not copy the image data (implicit sharing).
+      //
+      const QString codecName = value.value<QENTNDArrayData> ().getCodecName ();
+      return !(codecName.isEmpty () || codecName == "none");
+   }
+
+private:
+   // True when the connection state has changed since the frame was submitted.
+   //
+   inline bool isCancelled () const { return this->slot->getEpoch () != this->epoch; }
+
+   QEPvaClient::Update* item;
+   const UpdateSlotRef slot;
+   int epoch;
+   quint32 sequence;
+};
+
+//------------------------------------------------------------------------------
 //
-static QEThreadSafeQueue<QEPvaClient::Update*> pvaClientUpdateQueue;
+void QEPvaDecodeJob::run ()
+{
+   if (this->isCancelled ()) {
+      QEPvaClient::Update::release (this->item);
+      return;
+   }
+
+   // Skip the frame if it has been superseded before being started.
+   //
+   if (this->sequence != this->slot->decodeSubmitted.loadAcquire ()) {
+      this->slot->discardData (this->item);
+      return;
+   }
+
+   QENTNDArrayData arrayData;
+   arrayData.assignFromVariant (this->item->getPvData ());
+   arrayData.decompressData ();
+   this->item->setPvData (arrayData.toVariant ());
+
+   if (this->isCancelled ()) {
+      QEPvaClient::Update::release (this->item);
+      return;
+   }
+
+   // Record this frame as delivered unless a newer frame overtook it.
+   //
+   while (true) {
+      const quint32 delivered = this->slot->decodeDelivered.loadAcquire ();
+      if (qint32 (this->sequence - delivered) <= 0) {
+         this->slot->discardData (this->item);
+         return;
+      }
+      if (this->slot->decodeDelivered.testAndSetOrdered (delivered, this->sequence)) break;
+   }
+
+   this->slot->postData (this->item);
+}
 
 
 //==============================================================================
@@ -204,7 +773,8 @@ class QEPvaRequesterCommon
 public:
    explicit QEPvaRequesterCommon (const QEPvaClientReference& clientReferenceIn) :
       clientReference (clientReferenceIn),
-      pvName (clientReferenceIn.client()->getPvName ()) { }
+      pvName (clientReferenceIn.client()->getPvName ()),
+      updateSlot (clientReferenceIn.client()->updateSlot) { }
 
    ~QEPvaRequesterCommon () { }
    inline uint64_t uniqueId () const  { return this->clientReference.uniqueId (); }
@@ -212,6 +782,7 @@ public:
 protected:
    const QEPvaClientReference clientReference;
    const QString pvName;
+   const UpdateSlotRef updateSlot;
 
    void handleMessage (std::string const & message, pvd::MessageType messageType)
    {
@@ -274,19 +845,19 @@ void QEPvaChannelRequesterInterface::channelStateChange (pva::Channel::shared_po
          break;
 
       case pva::Channel::CONNECTED:
-         item = new QEPvaClient::Update (this->clientReference, "",
-                                         QEPvaClient::Update::ukConnection,
-                                         nullVariant, "",
-                                         true);
-         pvaClientUpdateQueue.enqueue (item);
+         item = QEPvaClient::Update::allocate (this->clientReference, "",
+                                               QEPvaClient::Update::ukConnection,
+                                               nullVariant, "",
+                                               true);
+         this->updateSlot->postConnection (item);
          break;
 
       case pva::Channel::DISCONNECTED:
-         item = new QEPvaClient::Update (this->clientReference, "",
-                                         QEPvaClient::Update::ukConnection,
-                                         nullVariant, "",
-                                         false);
-         pvaClientUpdateQueue.enqueue (item);
+         item = QEPvaClient::Update::allocate (this->clientReference, "",
+                                               QEPvaClient::Update::ukConnection,
+                                               nullVariant, "",
+                                               false);
+         this->updateSlot->postConnection (item);
          break;
 
       case pva::Channel::DESTROYED:
@@ -328,6 +899,10 @@ public:
 
 private:
    void processElement (pva::MonitorElement::const_shared_pointer element);
+
+   static bool fieldHasChanged (const pvd::PVStructure::shared_pointer& pv,
+                                const pvd::BitSet::shared_pointer& changed,
+                                const char* fieldName);
 };
 
 //------------------------------------------------------------------------------
@@ -405,21 +980,62 @@ void QEPvaMonitorRequesterInterface::processElement (pva::MonitorElement::const_
    // Create the update item
    //
    QEPvaClient::Update* item =
-         new QEPvaClient::Update (this->clientReference, pvIdentity,
-                                  QEPvaClient::Update::ukData, value, type, false);
+         QEPvaClient::Update::allocate (this->clientReference, pvIdentity,
+                                        QEPvaClient::Update::ukData, value, type, false);
 
-   // Extract associated meta data
+   // Extract associated meta data, but only if it has changed.
    //
-   item->enumeration.extract (pv);     // i.e. the choices
-   item->timeStamp.extract (pv);
-   item->alarm.extract (pv);
-   item->control.extract (pv);
-   item->display.extract (pv );
-   item->valueAlarm.extract (pv);
+   const pvd::BitSet::shared_pointer changed = element->changedBitSet;
+
+#define EXTRACT_META_DATA(flag, member, field)                       \
+   if (fieldHasChanged (pv, changed, field)) {                       \
+      item->member.extract (pv);                                     \
+      item->metaDataPresent |= QEPvaClient::Update::flag;            \
+   }
+
+   EXTRACT_META_DATA (mdEnumeration, enumeration, "value");   // i.e. the choices
+   EXTRACT_META_DATA (mdTimeStamp,   timeStamp,   "timeStamp");
+   EXTRACT_META_DATA (mdAlarm,       alarm,       "alarm");
+   EXTRACT_META_DATA (mdControl,     control,     "control");
+   EXTRACT_META_DATA (mdDisplay,     display,     "display");
+   EXTRACT_META_DATA (mdValueAlarm,  valueAlarm,  "valueAlarm");
+
+#undef EXTRACT_META_DATA
 
    // We have copied all the element data.
+   // Compressed image data is decompressed by the decode pool, which then
+   // posts the update. Otherwise it is posted directly.
    //
-   pvaClientUpdateQueue.enqueue (item);
+   if (QEPvaDecodeJob::isRequired (value)) {
+      pvaDecodePool->start (new QEPvaDecodeJob (item, this->updateSlot));
+   } else {
+      this->updateSlot->postData (item);
+   }
+}
+
+//------------------------------------------------------------------------------
+// static
+// Returns true if the named top level field, or any of its sub-fields, is
+// marked as changed. If there is no changed bit set, or the whole structure
+// is marked as changed (e.g. first update), this function returns true.
+// If the field does not exist, this function returns false; the first update
+// will have already recorded that the associated meta data is undefined.
+//
+bool QEPvaMonitorRequesterInterface::fieldHasChanged (const pvd::PVStructure::shared_pointer& pv,
+                                                      const pvd::BitSet::shared_pointer& changed,
+                                                      const char* fieldName)
+{
+   if (!changed) return true;
+   if (changed->get (0)) return true;   // whole structure
+
+   pvd::PVField::shared_pointer field = pv->getSubField (fieldName);
+   if (!field) return false;
+
+   const std::size_t offset = field->getFieldOffset ();
+   const std::size_t nextOffset = field->getNextFieldOffset ();
+   const pvd::int32 index = changed->nextSetBit (pvd::uint32 (offset));
+
+   return (index >= 0) && (std::size_t (index) < nextOffset);
 }
 
 //------------------------------------------------------------------------------
@@ -599,8 +1215,13 @@ QEPvaClient::QEPvaClient (const QString& pvName,
 
    this->id = "";
    this->pvData = nullVariant;
+   this->pvRequest = "";
    this->firstUpdate = false;
 
+   // The update slot is shared with the requesters - so create it first.
+   //
+   this->updateSlot = QSharedPointer<UpdateSlot> (new UpdateSlot ());
+
    // Create the channel, monitor, put and get requestor and convert to saved shared pointers
    //
    QEPvaClientReference clientReference (this, this->uniqueId);
@@ -639,7 +1260,7 @@ QEPvaClient::~QEPvaClient()
 //
 bool QEPvaClient::openChannel (const ChannelModesFlags modes)
 {
-   static const std::string monitorRequest ("field()");   // the lot - all fields
+   static const std::string defaultRequest ("field()");   // the lot - all fields
    static const std::string putRequest ("field(value)");  // just the value
 
    bool result = false;
@@ -649,6 +1270,20 @@ bool QEPvaClient::openChannel (const ChannelModesFlags modes)
       return false;
    }
 
+   // Use the specified get/monitor request, if any, provided it is valid.
+   //
+   std::string monitorRequest = defaultRequest;
+   if (!this->pvRequest.isEmpty()) {
+      pvd::CreateRequest::shared_pointer creator = pvd::CreateRequest::create();
+      if (creator->createRequest (this->pvRequest.toStdString()).get()) {
+         monitorRequest = this->pvRequest.toStdString();
+      } else {
+         DEBUG << this->getPvName() << "invalid pv request" << this->pvRequest
+               << QString::fromStdString (creator->getMessage())
+               << "- requesting all fields";
+      }
+   }
+
    // We need to hold a reference to the channel to keep it "alive"
    // The channel keeps the requestor and the monitor "alive".
    //
@@ -696,6 +1331,20 @@ bool QEPvaClient::openChannel (const ChannelModesFlags modes)
    return result;
 }
 
+//------------------------------------------------------------------------------
+//
+void QEPvaClient::setPvRequest (const QString& pvRequestIn)
+{
+   this->pvRequest = pvRequestIn.trimmed();
+}
+
+//------------------------------------------------------------------------------
+//
+QString QEPvaClient::getPvRequest () const
+{
+   return this->pvRequest;
+}
+
 //------------------------------------------------------------------------------
 //
 void QEPvaClient::closeChannel ()
@@ -961,14 +1610,21 @@ void QEPvaClient::processUpdate (QEPvaClient::Update* update)
          this->pvData = update->getPvData ();
          this->pvType = update->getPvType ();
 
-         // Assign other items.
+         // Assign other items - only those that have changed are present.
          //
-         this->alarm.assign (update->alarm);
-         this->timeStamp.assign (update->timeStamp);
-         this->display.assign (update->display);
-         this->control.assign (update->control);
-         this->valueAlarm.assign (update->valueAlarm);
-         this->enumeration.assign (update->enumeration);
+#define ASSIGN_META_DATA(flag, member)                              \
+         if (update->metaDataPresent & QEPvaClient::Update::flag) { \
+            this->member.assign (update->member);                   \
+         }
+
+         ASSIGN_META_DATA (mdAlarm,       alarm);
+         ASSIGN_META_DATA (mdTimeStamp,   timeStamp);
+         ASSIGN_META_DATA (mdDisplay,     display);
+         ASSIGN_META_DATA (mdControl,     control);
+         ASSIGN_META_DATA (mdValueAlarm,  valueAlarm);
+         ASSIGN_META_DATA (mdEnumeration, enumeration);
+
+#undef ASSIGN_META_DATA
 
          emit dataUpdated (this->firstUpdate);
          this->firstUpdate = false;
@@ -1011,6 +1667,15 @@ QEPvaClientManager::QEPvaClientManager () : QTimer (NULL)
    QObject::connect (this, SIGNAL (timeout ()),
                      this, SLOT   (timeoutHandler ()));
 
+   // Create the NTNDArray decode pool, if required.
+   //
+   QEAdaptationParameters ap ("QE_");
+   const int decodeThreads = ap.getInt ("pva_decode_threads", 2);
+   if (decodeThreads > 0) {
+      pvaDecodePool = new QThreadPool ();
+      pvaDecodePool->setMaxThreadCount (decodeThreads);
+   }
+
    pva::ClientFactory::start();
 
    pva::ChannelProviderRegistry::shared_pointer providerRegistry = pva::ChannelProviderRegistry::clients();
@@ -1024,7 +1689,15 @@ QEPvaClientManager::QEPvaClientManager () : QTimer (NULL)
 QEPvaClientManager::~QEPvaClientManager ()
 {
    pva::ClientFactory::stop();
-   pvaClientUpdateQueue.clear();
+
+   if (pvaDecodePool) {
+      pvaDecodePool->waitForDone ();
+      delete pvaDecodePool;
+      pvaDecodePool = NULL;
+   }
+
+   QEPvaClient::UpdateSlot::clearQueued ();
+   QEPvaClient::Update::clearPool ();
 }
 
 //------------------------------------------------------------------------------
@@ -1032,17 +1705,34 @@ QEPvaClientManager::~QEPvaClientManager ()
 //slots
 void QEPvaClientManager::timeoutHandler ()
 {
-   while (true) {
-      QEPvaClient::Update* item = nullptr;
-      bool ok = pvaClientUpdateQueue.dequeue (item);
-      if (!ok) break;  // all done
-      if (item) {
-         item->process();
-         delete item;
-      }
+   // The update slots are processed without any lock shared with the producers.
+   //
+   QEPvaClient::UpdateSlot::processQueued ();
+}
+
+//------------------------------------------------------------------------------
+// static
+void QEPvaClientManager::getQueueStatistics (int& depth, int& highWaterMark,
+                                             int& overflowCount, const bool reset)
+{
+   depth = pvaClientUpdateQueue.size () + pvaOverflowDepth.loadAcquire ();
+   highWaterMark = pvaClientUpdateQueue.getHighWaterMark ();
+   if (reset) {
+      overflowCount = pvaOverflowCount.fetchAndStoreOrdered (0);
+      pvaClientUpdateQueue.resetStatistics ();
+   } else {
+      overflowCount = pvaOverflowCount.loadAcquire ();
    }
 }
 
+//------------------------------------------------------------------------------
+// static
+int QEPvaClientManager::getCoalescedCount (const bool reset)
+{
+   if (reset) return pvaCoalescedCount.fetchAndStoreOrdered (0);
+   return pvaCoalescedCount.loadAcquire ();
+}
+
 //------------------------------------------------------------------------------
 //
 void QEPvaClientManager::aboutToQuitHandler ()
@@ -1060,6 +1750,8 @@ QEPvaClient::QEPvaClient (const QString& pvName,
 QEPvaClient::~QEPvaClient () { }
 bool QEPvaClient::openChannel (const ChannelModesFlags) { return false; }
 void QEPvaClient::closeChannel () { }
+void QEPvaClient::setPvRequest (const QString&) { }
+QString QEPvaClient::getPvRequest () const { return ""; }
 bool QEPvaClient::getIsConnected () const { return false; }
 bool QEPvaClient::dataIsAvailable () const { return false; }
 QString QEPvaClient::getId () const { return ""; }
@@ -1088,6 +1780,10 @@ void QEPvaClient::processUpdate (QEPvaClient::Update*) { }
 QEPvaClientManager::QEPvaClientManager () { }
 QEPvaClientManager::~QEPvaClientManager () { }
 void QEPvaClientManager::initialise () { }
+void QEPvaClientManager::getQueueStatistics (int& depth, int& highWaterMark,
+                                             int& overflowCount, const bool)
+{ depth = highWaterMark = overflowCount = 0; }
+int QEPvaClientManager::getCoalescedCount (const bool) { return 0; }
 void QEPvaClientManager::timeoutHandler () { }
 void QEPvaClientManager::aboutToQuitHandler () { }
 
@@ -32,6 +32,7 @@
 #include <QString>
 #include <QTimer>
 #include <QVariant>
+#include <QSharedPointer>
 #include <QEPvaCheck.h>
 
 #ifdef QE_INCLUDE_PV_ACCESS
@@ -51,7 +52,7 @@ class QE_FRAMEWORK_LIBRARY_SHARED_EXPORT QEPvaClient : public QEBaseClient
    Q_OBJECT
 public:
    class Update;       // differed
-   class UpdateQueue;  // differed
+   class UpdateSlot;   // differed
 
    explicit QEPvaClient (const QString& pvName,
                          QObject* parent);
@@ -60,6 +61,14 @@ public:
    bool openChannel (const ChannelModesFlags modes);
    void closeChannel ();
 
+   // The pvRequest used for get and monitor requests, e.g. "field(value,alarm)"
+   // or "record[queueSize=4,pipeline=true]field()". When empty, which is the
+   // default, the whole structure is requested. This takes effect when the
+   // channel is next opened.
+   //
+   void setPvRequest (const QString& pvRequest);
+   QString getPvRequest () const;
+
    // Override QEBaseClient parent functions.
    //
    QVariant getPvData () const;
@@ -107,6 +116,7 @@ private:
    QString id;             // e.g.  "epics:nt/NTScalar:1.0"
    QString pvType;         // e.g.  "double" when NTScalar or NTArray
    QVariant pvData;        // holds the value data
+   QString pvRequest;      // get/monitor request, empty means all fields
 
 #ifdef QE_INCLUDE_PV_ACCESS
    // We need to keep strong references to these objects.
@@ -126,9 +136,14 @@ private:
    QEPvaData::Control control;
    QEPvaData::Display display;
    QEPvaData::ValueAlarm valueAlarm;
+
+   // Pending updates from the pvAccess threads, shared with the requesters.
+   //
+   QSharedPointer<UpdateSlot> updateSlot;
 #endif
 
    friend class QEPvaClientReference;
+   friend class QEPvaRequesterCommon;
    friend class QEPvaPutRequesterInterface;
 };
 
@@ -139,6 +154,20 @@ private:
 //
 class QEPvaClientManager : private QTimer {
    Q_OBJECT
+public:
+   // Returns update queue statistics: the current queue depth, the high water mark
+   // and the number of times a client's pending updates were placed on the overflow
+   // list because the queue was full.
+   // If reset is true, the high water mark and overflow count are reset.
+   //
+   static void getQueueStatistics (int& depth, int& highWaterMark,
+                                   int& overflowCount, const bool reset = false);
+
+   // Returns the number of data updates superseded by a newer data update for
+   // the same client before being processed.
+   //
+   static int getCoalescedCount (const bool reset = false);
+
 private:
    explicit QEPvaClientManager ();
    ~QEPvaClientManager ();
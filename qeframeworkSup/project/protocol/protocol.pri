@@ -33,6 +33,9 @@ SOURCES += $$PWD/QEBaseClient.cpp
 HEADERS += $$PWD/QECaClient.h
 SOURCES += $$PWD/QECaClient.cpp
 
+HEADERS += $$PWD/QEChannelRegistry.h
+SOURCES += $$PWD/QEChannelRegistry.cpp
+
 HEADERS += $$PWD/QENTNDArrayData.h
 SOURCES += $$PWD/QENTNDArrayData.cpp
 
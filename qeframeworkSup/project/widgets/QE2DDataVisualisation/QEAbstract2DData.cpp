@@ -402,11 +402,10 @@ void QEAbstract2DData::getDataMinMaxValues (double& min, double& max) const
    // Process each data set "row" in turn.
    //
    for (int j = 0; j < number; j++) {
-      QEFloatingArray dataSet = this->data.value (j);
-      const int m = dataSet.count ();
-      if (m == 0) continue;
-      const double dataSetMin = dataSet.minimumValue (tempMin, false);
-      const double dataSetMax = dataSet.maximumValue (tempMax, false);
+      const QEFloatingArray dataSet = this->data.value (j);
+      double dataSetMin;
+      double dataSetMax;
+      if (!dataSet.minMaxValues (dataSetMin, dataSetMax, false)) continue;
       tempMin = MIN (tempMin, dataSetMin);
       tempMax = MAX (tempMax, dataSetMax);
    }
@@ -356,6 +356,14 @@ public:
     ///
     Q_PROPERTY(bool oosAware READ getOosAware WRITE setOosAware)
 
+    /// Maximum rate, in Hz, at which data updates are delivered to the widget. Default is 0.
+    /// When non zero, updates arriving faster than this rate are coalesced, i.e. the latest value wins.
+    /// Alarm state changes and connection changes are never held back.
+    /// When 0 the application default applies (see the QE_MAX_UPDATE_RATE adaptation parameter),
+    /// which in turn defaults to unlimited.
+    ///
+    Q_PROPERTY(double maximumUpdateRate READ getMaximumUpdateRate WRITE setMaximumUpdateRate)
+
 public:
     // END-STANDARD-PROPERTIES ========================================================
 
@@ -464,8 +464,9 @@ void QEDistribution::updateDistribution ()
 
    // Distribute values over the distribution data array.
    //
-   this->pvData.distribute (this->distributionData, this->distributionCount,
-                            true, this->currentXPlotMin, this->distributionIncrement);
+   this->pvStats.getDistribution (this->pvData,
+                                  this->distributionData, this->distributionCount,
+                                  true, this->currentXPlotMin, this->distributionIncrement);
 
    // Find the total and also find the max value so that we can calculate
    // a sensible y scale.
@@ -574,7 +575,7 @@ void QEDistribution::tickTimeout ()
       // Recalc the stats, and check is calc okay.
       //
       QCaDataPointList::Statistics stats;
-      if (this->pvData.calculateStatistics (stats, true)) {
+      if (this->pvStats.getStatistics (this->pvData, stats, true)) {
          // Yes - the calc is okay.
          //
          this->countValueLabel->setNum (this->pvData.count ());
@@ -846,11 +847,13 @@ void QEDistribution::connectionChanged (QCaConnectionInfo& connectionInfo,
       QCaDataPoint point = this->pvData.last ();
       point.datetime = QDateTime::currentDateTime ().toUTC ();
       this->pvData.append (point);
+      this->pvStats.pointAppended (this->pvData);
 
       // create a dummy point with same time but marked invalid to indicate a break.
       //
       point.alarm = QCaAlarmInfo (NO_ALARM, INVALID_ALARM);
       this->pvData.append (point);
+      this->pvStats.pointAppended (this->pvData);
    }
 
    // Display the connected state
@@ -900,10 +903,12 @@ void QEDistribution::setPvValue (const double& value, QCaAlarmInfo& alarmInfo,
    point.datetime = timestamp;
    point.alarm = alarmInfo;
    this->pvData.append (point);
+   this->pvStats.pointAppended (this->pvData);
 
    // Don't let this data set tooo big.
    //
    if (this->pvData.count () >= MAXIMUM_DATA_POINTS) {
+      this->pvStats.removingFirstPoint (this->pvData);
       this->pvData.removeFirst();
    }
 
@@ -1320,6 +1325,7 @@ void QEDistribution::resetDistibution ()
    const QString nil ("n/a");
 
    this->pvData.clear ();
+   this->pvStats.clear ();
    this->valueTotal = 0.0;
    this->valueMean = 0.0;
    this->valueStdDev = 0.0;
@@ -41,6 +41,7 @@
 #include <QEEnums.h>
 #include <QECommon.h>
 #include <QCaDataPoint.h>
+#include <QCaDataPointStatistics.h>
 #include <QEAbstractDynamicWidget.h>
 #include <QEFloatingFormatting.h>
 #include <QEStringFormatting.h>
@@ -93,6 +94,30 @@ public:
    /// Index used to select a single item of data for processing. The default is 0.
    ///
    Q_PROPERTY (int arrayIndex READ getArrayIndex WRITE setArrayIndex)
+
+   /// Absolute deadband. Scalar numeric updates that differ from the last delivered value
+   /// by no more than this amount are not delivered. Default is 0.0, i.e. no deadband.
+   ///
+   Q_PROPERTY (double absoluteDeadband READ getAbsoluteDeadband WRITE setAbsoluteDeadband)
+
+   /// Relative deadband, as a percentage of the last delivered value. Default is 0.0, i.e. no deadband.
+   ///
+   Q_PROPERTY (double relativeDeadband READ getRelativeDeadband WRITE setRelativeDeadband)
+
+   /// When true, a deadband is derived from the display precision so that changes that
+   /// would not be visible are not delivered. Default is false.
+   ///
+   Q_PROPERTY (bool autoDeadband READ getAutoDeadband WRITE setAutoDeadband)
+
+   /// Minimum interval (mSec) between delivered updates, the latest value wins. Default is 0, i.e. none.
+   ///
+   Q_PROPERTY (int minimumUpdateInterval READ getMinimumUpdateInterval WRITE setMinimumUpdateInterval)
+
+   /// PV Access only. The pvRequest used to get and monitor the PV, e.g. field(value,alarm,timeStamp)
+   /// to avoid display and control updates, or record[queueSize=4,pipeline=true] for flow control.
+   /// Overrides any request specified as part of the variable name. Default is empty, i.e. all fields.
+   ///
+   Q_PROPERTY (QString pvRequest READ getPvRequest WRITE setPvRequest)
    //
    // END-SINGLE-VARIABLE-V2-PROPERTIES =================================================
 
@@ -242,6 +267,7 @@ private:
 
    static QTimer* tickTimer;
    QCaDataPointList pvData;
+   QCaDataPointStatistics pvStats;    // incrementally tracks pvData
 
    double valueMean;
    double valueStdDev;
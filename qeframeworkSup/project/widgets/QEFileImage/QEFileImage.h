@@ -84,6 +84,30 @@ public:
    /// Index used to select a single item of data for processing. The default is 0.
    ///
    Q_PROPERTY (int arrayIndex READ getArrayIndex WRITE setArrayIndex)
+
+   /// Absolute deadband. Scalar numeric updates that differ from the last delivered value
+   /// by no more than this amount are not delivered. Default is 0.0, i.e. no deadband.
+   ///
+   Q_PROPERTY (double absoluteDeadband READ getAbsoluteDeadband WRITE setAbsoluteDeadband)
+
+   /// Relative deadband, as a percentage of the last delivered value. Default is 0.0, i.e. no deadband.
+   ///
+   Q_PROPERTY (double relativeDeadband READ getRelativeDeadband WRITE setRelativeDeadband)
+
+   /// When true, a deadband is derived from the display precision so that changes that
+   /// would not be visible are not delivered. Default is false.
+   ///
+   Q_PROPERTY (bool autoDeadband READ getAutoDeadband WRITE setAutoDeadband)
+
+   /// Minimum interval (mSec) between delivered updates, the latest value wins. Default is 0, i.e. none.
+   ///
+   Q_PROPERTY (int minimumUpdateInterval READ getMinimumUpdateInterval WRITE setMinimumUpdateInterval)
+
+   /// PV Access only. The pvRequest used to get and monitor the PV, e.g. field(value,alarm,timeStamp)
+   /// to avoid display and control updates, or record[queueSize=4,pipeline=true] for flow control.
+   /// Overrides any request specified as part of the variable name. Default is empty, i.e. all fields.
+   ///
+   Q_PROPERTY (QString pvRequest READ getPvRequest WRITE setPvRequest)
    //
    // END-SINGLE-VARIABLE-V2-PROPERTIES =================================================
 
@@ -191,6 +215,14 @@ public:
     ///
     Q_PROPERTY(bool oosAware READ getOosAware WRITE setOosAware)
 
+    /// Maximum rate, in Hz, at which data updates are delivered to the widget. Default is 0.
+    /// When non zero, updates arriving faster than this rate are coalesced, i.e. the latest value wins.
+    /// Alarm state changes and connection changes are never held back.
+    /// When 0 the application default applies (see the QE_MAX_UPDATE_RATE adaptation parameter),
+    /// which in turn defaults to unlimited.
+    ///
+    Q_PROPERTY(double maximumUpdateRate READ getMaximumUpdateRate WRITE setMaximumUpdateRate)
+
 public:
    // END-STANDARD-PROPERTIES ========================================================
 
@@ -36,6 +36,7 @@
 #include <QDebug>
 #include <QECommon.h>
 #include <QEScaling.h>
+#include <QEVectorVariants.h>
 
 #include <QELabel.h>
 #include <QERadioGroup.h>
@@ -287,12 +288,21 @@ void QEGeneralEdit::dataChanged (const QVariant& value, QCaAlarmInfo& alarmInfo,
       QVariant workingValue = value;
       QVariant::Type type = workingValue.type ();
 
+      // Own vector variants are converted to a list - this is not a time critical function.
+      //
+      if (QEVectorVariants::isVectorVariant (workingValue)) {
+         bool okay;
+         workingValue = QEVectorVariants::convertToVariantList (value, okay);
+         type = workingValue.type ();
+      }
+
       if (type == QVariant::List) {
+         const QVariantList list = workingValue.toList();
          int ai = this->getArrayIndex();
-         if (ai >= 0 && ai < value.toList().count() ) {
+         if (ai >= 0 && ai < list.count() ) {
             // Convert this array element as a scalar update.
             //
-            workingValue =value.toList().value(ai);
+            workingValue = list.value(ai);
             type = workingValue.type ();
          } else {
             DEBUG << " Array index out of bounds:" << ai;
@@ -27,6 +27,7 @@
 #include "QEWaveformHistogram.h"
 #include <QDebug>
 #include <QCaObject.h>
+#include <QEVectorVariants.h>
 #include <QEPVNameSelectDialog.h>
 
 #define DEBUG  qDebug () << "QEWaveformHistogram"  << __LINE__ << __FUNCTION__ << "  "
@@ -477,7 +478,11 @@ void QEWaveformHistogram::genReadOut (const int index)
       text = qca->getRecordName ().append (QString (" [%1]").arg (index + 1));
 
       if (isDefined) {
-         value = valueList.toList ().value (index);
+         if (QEVectorVariants::isVectorVariant (valueList)) {
+            value = QEVectorVariants::getVariantValue (valueList, index, QVariant ());
+         } else {
+            value = valueList.toList ().value (index);
+         }
          this->stringFormatting.setDbEgu (qca->getEgu ());
          text.append (" ").append (this->stringFormatting.formatString (value, 0));
       } else {
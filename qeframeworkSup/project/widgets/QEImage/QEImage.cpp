@@ -1761,9 +1761,13 @@ void QEImage::setPvaImage( const QVariant& value,
     // Update the image buffer according to the new size.
     setImageSize();
 
-    // Call the standard CA set image
-    setImage( imageData.getData(), imageData.getBytesPerPixel(),
-              alarmInfo, timeStamp, variableIndex );
+    // Call the standard CA set image.
+    // Use a zero copy view of the image data where possible - the owner keeps
+    // the underlying pvData memory alive while referenced by the image processor.
+    QSharedPointer<void> imageOwner;
+    QByteArray imageView = imageData.getDataView( imageOwner );
+    setImage( imageView, imageData.getBytesPerPixel(),
+              alarmInfo, timeStamp, variableIndex, imageOwner );
 
     this->updateToolTipAlarm (alarmInfo, variableIndex);
 }
@@ -1776,12 +1780,15 @@ void QEImage::setPvaImage( const QVariant& value,
     Note the following comments from the Qt help:
         Note: Drawing into a QImage with QImage::Format_Indexed8 is not supported.
         Note: Do not render into ARGB32 images using QPainter. Using QImage::Format_ARGB32_Premultiplied is significantly faster.
+    If set, imageOwner keeps the underlying data alive when imageIn is a zero copy view
+    of data owned elsewhere, e.g. PVA data.
  */
 void QEImage::setImage( const QByteArray& imageIn,
                         unsigned long dataSize,
                         QCaAlarmInfo& alarmInfo,
                         QCaDateTime& time,
-                        const unsigned int& variableIndex )
+                        const unsigned int& variableIndex,
+                        const QSharedPointer<void>& imageOwner )
 {
     // Do nothing regarding the image until the width and height are available
     if( iProcessor.getImageBuffWidth() == 0 || iProcessor.getImageBuffHeight() == 0 )
@@ -1798,14 +1805,22 @@ void QEImage::setImage( const QByteArray& imageIn,
     // If recording, save image
     if( recorder && recorder->isRecording() )
     {
-        recorder->recordImage( imageIn, dataSize, alarmInfo, time );
+        if( imageOwner )
+        {
+            // Image data is a view onto PVA data - the recorder retains images, so take a copy.
+            recorder->recordImage( QByteArray( imageIn.constData(), imageIn.size() ), dataSize, alarmInfo, time );
+        }
+        else
+        {
+            recorder->recordImage( imageIn, dataSize, alarmInfo, time );
+        }
     }
 
     // Signal a database value change to any Link widgets
     emit dbValueChanged( "image" );
 
     // Save the image data for analysis and redisplay
-    iProcessor.setImage( imageIn, dataSize );
+    iProcessor.setImage( imageIn, dataSize, imageOwner );
 
     // Note the time of this image
     imageTime = time;
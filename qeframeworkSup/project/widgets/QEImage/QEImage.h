@@ -28,6 +28,7 @@
 #define QE_IMAGE_H
 
 #include <QScrollArea>
+#include <QSharedPointer>
 #include <QEEnums.h>
 #include <QEWidget.h>
 #include <QEInteger.h>
@@ -603,8 +604,10 @@ public slots:
                       const unsigned int& variableIndex );
 
     // Channel Access Image/NDArray data update slot
+    // The optional image owner keeps zero copy image data alive.
     void setImage( const QByteArray& image, unsigned long dataSize,
-                   QCaAlarmInfo&, QCaDateTime&, const unsigned int& );
+                   QCaAlarmInfo&, QCaDateTime&, const unsigned int&,
+                   const QSharedPointer<void>& imageOwner = QSharedPointer<void>() );
 
     void connectionChanged( QCaConnectionInfo& connectionInfo, const unsigned int& variableIndex);
 
@@ -1491,6 +1494,14 @@ public:
     ///
     Q_PROPERTY(bool oosAware READ getOosAware WRITE setOosAware)
 
+    /// Maximum rate, in Hz, at which data updates are delivered to the widget. Default is 0.
+    /// When non zero, updates arriving faster than this rate are coalesced, i.e. the latest value wins.
+    /// Alarm state changes and connection changes are never held back.
+    /// When 0 the application default applies (see the QE_MAX_UPDATE_RATE adaptation parameter),
+    /// which in turn defaults to unlimited.
+    ///
+    Q_PROPERTY(double maximumUpdateRate READ getMaximumUpdateRate WRITE setMaximumUpdateRate)
+
 public:
     // END-STANDARD-PROPERTIES ========================================================
 
@@ -132,10 +132,14 @@ void imageProcessor::run()
 }
 
 // Save the image data for analysis, processing and display
-void imageProcessor::setImage( const QByteArray& imageIn, unsigned long dataSize )
+// If the image data is a raw view onto memory owned elsewhere (no copy made), imageOwner
+// must keep that memory alive. It is held for as long as the image data is referenced.
+void imageProcessor::setImage( const QByteArray& imageIn, unsigned long dataSize,
+                               const QSharedPointer<void>& imageOwner )
 {
     // Save the current image
     imageData = imageIn;
+    imageDataOwner = imageOwner;
     receivedImageSize = (unsigned long) imageData.size ();
     imageDataSize = dataSize;
 
@@ -229,6 +233,7 @@ void imageProcessor::buildImage()
 
         // Package up the current image data and all related information
         next = new imagePropertiesCore( imageData,
+                                        imageDataOwner,
                                         imageBuffWidth,
                                         imageBuffHeight,
                                         getScanOption(),
@@ -256,6 +261,7 @@ void imageProcessor::buildImage()
 // Package up image data along with all the information
 // needed to process it and generate a QImage.
 imagePropertiesCore::imagePropertiesCore( QByteArray imageDataIn,
+                                          QSharedPointer<void> imageDataOwnerIn,
                                           unsigned long imageBuffWidthIn,
                                           unsigned long imageBuffHeightIn,
                                           int scanOptionIn,
@@ -271,6 +277,7 @@ imagePropertiesCore::imagePropertiesCore( QByteArray imageDataIn,
                                           unsigned int rotatedImageBuffHeightIn )
 {
     imageData = imageDataIn;
+    imageDataOwner = imageDataOwnerIn;
     imageBuffWidth = imageBuffWidthIn;
     imageBuffHeight = imageBuffHeightIn;
     scanOption = scanOptionIn;
@@ -50,7 +50,8 @@ public:
     ~imageProcessor();                                                  ///< Destructor
 
     // Image update
-    void setImage( const QByteArray& imageIn, unsigned long dataSize ); ///< Save the image data for analysis processing and display
+    void setImage( const QByteArray& imageIn, unsigned long dataSize,
+                   const QSharedPointer<void>& imageOwner = QSharedPointer<void>() ); ///< Save the image data for analysis processing and display
     void buildImage();                                                  ///< Generate a new image.
 
     // Set functions for dimensions and image attributes
@@ -27,6 +27,7 @@
 #ifndef QE_IMAGE_PROPERTIES_H
 #define QE_IMAGE_PROPERTIES_H
 
+#include <QSharedPointer>
 #include "QCaDateTime.h"
 #include <QEEnums.h>
 #include "imageDataFormats.h"
@@ -53,6 +54,7 @@ class imagePropertiesCore
 {
 public:
     imagePropertiesCore( QByteArray imageDataIn,
+                         QSharedPointer<void> imageDataOwnerIn,
                          unsigned long imageBuffWidthIn,
                          unsigned long imageBuffHeightIn,
                          int scanOptionIn,
@@ -70,6 +72,7 @@ public:
     QImage buildImageCore();
 private:
     QByteArray imageData;             // Buffer to hold original image data.
+    QSharedPointer<void> imageDataOwner; // Keeps image data memory alive when imageData is a raw (zero copy) view
     unsigned long imageBuffWidth;     // Original image width (may be generated directly from a width variable, or selected from the relevent dimension variable)
     unsigned long imageBuffHeight;    // Original image height (may be generated directly from a width variable, or selected from the relevent dimension variable)
     int scanOption;
@@ -142,6 +145,7 @@ protected:
     unsigned long elementsPerPixel;   // Number of data elements per pixel. Derived from image dimension 0 (only when there are three dimensions)
     unsigned long bytesPerPixel;      // Bytes in input data per pixel (imageDataSize * elementsPerPixel)
     QByteArray imageData;                 // Buffer to hold original image data.
+    QSharedPointer<void> imageDataOwner;  // Keeps image data memory alive when imageData is a raw (zero copy) view
     unsigned long receivedImageSize;  // Size as received on last CA update.
     QString previousMessageText;      // Previous message text - avoid repeats.
     QImage image;                     // Last image generated. Kept as the widget may ask for it again. For example, if the user is saving it.
@@ -2593,20 +2593,25 @@ void QEPlotter::plot ()
       ydata = QEFloatingArray (ys->data.mid (0, number));
 
       // Gather, save and aggregate minimun and maximum values.
-      // We ignore +/- inf values.
+      // We ignore +/- inf values. Values default to 0.0 if no usable values.
       //
+      double dataMin = 0.0;
+      double dataMax = 0.0;
+      xdata.minMaxValues (dataMin, dataMax, false);
+
       if (xMinMaxDefined) {
          // merge
-         xMin = MIN (xMin, xdata.minimumValue (0.0, false));
-         xMax = MAX (xMax, xdata.maximumValue (0.0, false));
+         xMin = MIN (xMin, dataMin);
+         xMax = MAX (xMax, dataMax);
       } else {
-         xMin = xdata.minimumValue ();
-         xMax = xdata.maximumValue ();
+         xMin = dataMin;
+         xMax = dataMax;
          xMinMaxDefined = true;
       }
 
-      ys->plottedMin = ydata.minimumValue ();
-      ys->plottedMax = ydata.maximumValue ();
+      ys->plottedMin = 0.0;
+      ys->plottedMax = 0.0;
+      ydata.minMaxValues (ys->plottedMin, ys->plottedMax, false);
 
       if (yMinMaxDefined) {
          // merge
@@ -960,6 +960,11 @@ void QEPvLoadSaveLeaf::dataChanged (const QVariant& valueIn, QCaAlarmInfo& alarm
       } else {
          this->liveValue = valueIn;
       }
+   } else if (QEVectorVariants::isVectorVariant (valueIn)) {
+      // The load/save model and file format are list based.
+      //
+      bool okay;
+      this->liveValue = QEVectorVariants::convertToVariantList (valueIn, okay);
    } else {
       this->liveValue = valueIn;
    }
@@ -85,6 +85,11 @@ QEStripChartContextMenu::QEStripChartContextMenu (bool inUseIn, QWidget *parent)
       this->make (menu, "User PV Process Time",                true,  QEStripChartNames::SCCM_PLOT_SERVER_TIME);
       this->make (menu, "Use Receive Time",                    true,  QEStripChartNames::SCCM_PLOT_CLIENT_TIME);
 
+      menu->addSeparator();
+      this->make (menu, "Stride Decimation",                   true,  QEStripChartNames::SCCM_DECIMATE_STRIDE);
+      this->make (menu, "Min/Max Decimation",                  true,  QEStripChartNames::SCCM_DECIMATE_MIN_MAX);
+      this->make (menu, "LTTB Decimation",                     true,  QEStripChartNames::SCCM_DECIMATE_LTTB);
+
       menu->addSeparator();
       this->make (menu, "Linear",                              true,  QEStripChartNames::SCCM_ARCH_LINEAR);
       this->make (menu, "Plot Binning",                        true,  QEStripChartNames::SCCM_ARCH_PLOTBIN);
@@ -261,6 +266,24 @@ void QEStripChartContextMenu::setLinePlotMode (const QEStripChartNames::LinePlot
    }
 }
 
+//------------------------------------------------------------------------------
+//
+void QEStripChartContextMenu::setDecimationMode (const QEStripChartNames::DecimationModes mode)
+{
+   // Maps How types to options.
+   // NOTE: If the DecimationModes defition changes, so must this.
+   //
+   static const QEStripChartNames::ContextMenuOptions optionMap [] = {
+      QEStripChartNames::SCCM_DECIMATE_STRIDE,
+      QEStripChartNames::SCCM_DECIMATE_MIN_MAX,
+      QEStripChartNames::SCCM_DECIMATE_LTTB
+   };
+
+   for (int j = 0; j < ARRAY_LENGTH (optionMap); j++) {
+      this->setActionChecked (optionMap [j], (j == int(mode)));
+   }
+}
+
 //------------------------------------------------------------------------------
 //
 void QEStripChartContextMenu::contextMenuTriggered (QAction* selectedItem)
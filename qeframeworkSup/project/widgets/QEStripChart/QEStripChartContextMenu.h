@@ -62,6 +62,7 @@ public:
    void setArchiveReadHow  (const QEArchiveInterface::How how);
    void setLineDrawMode    (const QEStripChartNames::LineDrawModes mode);
    void setLinePlotMode    (const QEStripChartNames::LinePlotModes mode);
+   void setDecimationMode  (const QEStripChartNames::DecimationModes mode);
 
 signals:
    // All the triggered actions from the various sub-menu items are
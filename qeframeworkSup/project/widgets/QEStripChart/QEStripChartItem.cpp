@@ -42,6 +42,7 @@
 #include <QEPlatform.h>
 #include <QEGraphic.h>
 #include <QEScaling.h>
+#include <QEVectorVariants.h>
 #include "QEStripChartContextMenu.h"
 #include "QEStripChartStatistics.h"
 
@@ -178,6 +179,14 @@ QEStripChartItem::QEStripChartItem (QEStripChart* chartIn,
                      this,                 SLOT   (setArchiveData (const QObject*, const bool, const QCaDataPointList&,
                                                                    const QString&, const QString&)));
 
+   // Large reads are displayed as each batch of data arrives.
+   //
+   this->archiveAccess.setIncrementalResponses (true);
+   QObject::connect (&this->archiveAccess, SIGNAL (appendArchiveData (const QObject*, const QCaDataPointList&,
+                                                                      const QString&)),
+                     this,                 SLOT   (appendArchiveData (const QObject*, const QCaDataPointList&,
+                                                                      const QString&)));
+
 
    this->connect (this->pvName, SIGNAL (customContextMenuRequested (const QPoint &)),
                   this,         SLOT   (contextMenuRequested (const QPoint &)));
@@ -278,6 +287,7 @@ void QEStripChartItem::clear ()
    this->historicalMinMax.clear ();
    this->realTimeMinMax.clear ();
    this->historicalTimeDataPoints.clear ();
+   this->archiveBatchesReceived = false;
    this->dashExists = false;
    this->realTimeDataPoints.clear ();
    this->maxRealTimePoints = getMaxRealTimePoints ();
@@ -288,6 +298,7 @@ void QEStripChartItem::clear ()
    this->archiveReadHow = QEArchiveInterface::PlotBinning;
    this->lineDrawMode = QEStripChartNames::ldmRegular;
    this->linePlotMode = QEStripChartNames::lpmRectangular;
+   this->decimationMode = QEStripChartNames::dmMinMax;
 
    // Reset identity sclaing
    //
@@ -573,6 +584,244 @@ QEDisplayRanges QEStripChartItem::getBufferedMinMax (bool doScale) const
    return result;
 }
 
+//==============================================================================
+// Decimation functions used by plotDataPoints.
+// Each determines the indices of the points in the range [first, last] that are
+// to be plotted. The first and last points are always selected, as are points
+// where the displayability changes, so that the start/end edge effects and the
+// breaks in the plotted curve are preserved.
+//==============================================================================
+//
+// Appends up to four indices in increasing order, skipping duplicates.
+//
+static void appendIndices (QVector<int>& indices, int a, int b, int c, int d)
+{
+   int item [4] = { a, b, c, d };
+
+   // Simple insertion sort - only 4 items.
+   //
+   for (int i = 1; i < 4; i++) {
+      const int x = item [i];
+      int k = i - 1;
+      while (k >= 0 && item [k] > x) {
+         item [k + 1] = item [k];
+         k--;
+      }
+      item [k + 1] = x;
+   }
+
+   for (int i = 0; i < 4; i++) {
+      if (item [i] < 0) continue;
+      if (!indices.isEmpty () && item [i] <= indices.last ()) continue;
+      indices.append (item [i]);
+   }
+}
+
+//------------------------------------------------------------------------------
+// Plot every decimation-th point.
+//
+static void strideDecimate (QVector<int>& indices,
+                            const int first, const int last,
+                            const int decimation)
+{
+   for (int j = first; j <= last; j += decimation) {
+      indices.append (j);
+   }
+   if (indices.last () != last) indices.append (last);
+}
+
+//------------------------------------------------------------------------------
+// Selects the first, minimum, maximum and last points of each run of points of
+// the same displayability within the index range [lo, hi].
+//
+static void minMaxScan (QVector<int>& indices,
+                        const QCaDataPointList& dataPoints,
+                        const int lo, const int hi)
+{
+   bool runIsDisplayable = false;
+   int runFirst = -1;
+   int runLast = -1;
+   int runMin = -1;
+   int runMax = -1;
+   double minValue = 0.0;
+   double maxValue = 0.0;
+
+   for (int j = lo; j <= hi; j++) {
+      const bool isDisplayable = dataPoints.isDisplayable (j);
+
+      if ((runFirst < 0) || (isDisplayable != runIsDisplayable)) {
+         // Start of a new run - save the previous run's points, if any.
+         //
+         appendIndices (indices, runFirst, runMin, runMax, runLast);
+
+         runIsDisplayable = isDisplayable;
+         runFirst = runLast = runMin = runMax = j;
+         minValue = maxValue = dataPoints.getValue (j);
+         continue;
+      }
+
+      runLast = j;
+
+      // The value of an undisplayable point is irrelevant.
+      //
+      if (!isDisplayable) continue;
+
+      const double value = dataPoints.getValue (j);
+      if (value < minValue) {
+         minValue = value;
+         runMin = j;
+      }
+      if (value > maxValue) {
+         maxValue = value;
+         runMax = j;
+      }
+   }
+
+   appendIndices (indices, runFirst, runMin, runMax, runLast);
+}
+
+//------------------------------------------------------------------------------
+// For each pixel column (bucket), select the first, minimum, maximum and last
+// points (M4 aggregation). This guarantees that the plotted envelope is the
+// same as that of the undecimated data, i.e. transients are not lost.
+// The per bucket min/max is obtained from the list's summary pyramid, so the
+// cost is proportional to the number of buckets, not the number of points.
+//
+static void minMaxDecimate (QVector<int>& indices,
+                            const QCaDataPointList& dataPoints,
+                            const int first, const int last,
+                            const qint64 startNSecs, const qint64 endNSecs,
+                            const int buckets)
+{
+   const double span = double (endNSecs - startNSecs);
+
+   indices.append (first);
+
+   int lo = first + 1;
+   for (int k = 1; (k <= buckets) && (lo < last); k++) {
+      const qint64 bucketEndNSecs = (k == buckets) ? endNSecs
+                                                   : startNSecs + qint64 (span * k / buckets);
+      const int hi = MIN (dataPoints.indexBeforeNSecs (bucketEndNSecs, lo - 1), last - 1);
+      if (hi < lo) continue;   // empty bucket
+
+      const QCaDataPointList::Summary summary = dataPoints.getSummary (lo, hi);
+      if ((summary.undisplayable == 0) || (summary.count == 0)) {
+         // All points have the same displayability.
+         //
+         appendIndices (indices, lo, summary.minIndex, summary.maxIndex, hi);
+      } else {
+         minMaxScan (indices, dataPoints, lo, hi);
+      }
+
+      lo = hi + 1;
+   }
+
+   // Belts 'n' braces - any remaining interior points.
+   //
+   if (lo < last) {
+      minMaxScan (indices, dataPoints, lo, last - 1);
+   }
+
+   appendIndices (indices, last, -1, -1, -1);
+}
+
+//------------------------------------------------------------------------------
+// Largest-Triangle-Three-Buckets (S. Steinarsson). The interior points are
+// divided into threshold buckets, and from each bucket the point that forms
+// the largest triangle with the previously selected point and the average of
+// the next bucket is selected.
+//
+static void lttbDecimate (QVector<int>& indices,
+                          const QCaDataPointList& dataPoints,
+                          const int first, const int last,
+                          const int threshold)
+{
+   const int interior = last - first - 1;
+   const qint64 originNSecs = dataPoints.getNSecsSinceEpoch (first);
+
+   indices.append (first);
+
+   if (interior > threshold) {
+      const double bucketSize = double (interior) / double (threshold);
+
+      int a = first;
+      double ta = 0.0;
+      double ya = dataPoints.getValue (first);
+
+      for (int b = 0; b < threshold; b++) {
+         const int bucketStart = first + 1 + int (b * bucketSize);
+         const int bucketEnd   = MIN (first + 1 + int ((b + 1) * bucketSize), last);   // exclusive
+
+         // Average point of the next bucket - for the last bucket, this is the last point.
+         //
+         const int nextEnd = (b + 1 < threshold) ? MIN (first + 1 + int ((b + 2) * bucketSize), last)
+                                                 : last + 1;
+         double sumT = 0.0;
+         double sumY = 0.0;
+         int number = 0;
+         for (int k = bucketEnd; k < nextEnd; k++) {
+            if (!dataPoints.isDisplayable (k)) continue;
+            sumT += double (dataPoints.getNSecsSinceEpoch (k) - originNSecs) * 1.0e-9;
+            sumY += dataPoints.getValue (k);
+            number++;
+         }
+
+         double avgT;
+         double avgY;
+         if (number > 0) {
+            avgT = sumT / number;
+            avgY = sumY / number;
+         } else {
+            avgT = double (dataPoints.getNSecsSinceEpoch (last) - originNSecs) * 1.0e-9;
+            avgY = ya;
+         }
+
+         // Find the point with the largest triangle area (times 2).
+         // Also select any point where the displayability changes.
+         //
+         int selected = -1;
+         double maxArea = -1.0;
+         for (int k = bucketStart; k < bucketEnd; k++) {
+            const bool isDisplayable = dataPoints.isDisplayable (k);
+            if (isDisplayable != dataPoints.isDisplayable (k - 1)) {
+               appendIndices (indices, k, -1, -1, -1);
+            }
+            if (!isDisplayable) continue;
+
+            const double tk = double (dataPoints.getNSecsSinceEpoch (k) - originNSecs) * 1.0e-9;
+            const double yk = dataPoints.getValue (k);
+            const double area = ABS ((ta - avgT) * (yk - ya) - (ta - tk) * (avgY - ya));
+            if (area > maxArea) {
+               maxArea = area;
+               selected = k;
+            }
+         }
+
+         if (selected >= 0 && selected != a) {
+            // Transitions and the selected point may interleave - re-sort this
+            // bucket's contribution.
+            //
+            int n = indices.count ();
+            while (n > 0 && indices.at (n - 1) > selected) n--;
+            if (n == 0 || indices.at (n - 1) != selected) {
+               indices.insert (n, selected);
+            }
+
+            a = selected;
+            ta = double (dataPoints.getNSecsSinceEpoch (a) - originNSecs) * 1.0e-9;
+            ya = dataPoints.getValue (a);
+         }
+      }
+
+   } else {
+      for (int j = first + 1; j < last; j++) {
+         indices.append (j);
+      }
+   }
+
+   appendIndices (indices, last, -1, -1, -1);
+}
+
 //------------------------------------------------------------------------------
 // macro functions to convert real-world values to a plot values,
 // doing safe log conversion if required.
@@ -605,8 +854,7 @@ void QEStripChartItem::plotDataPoints (const QCaDataPointList& dataPoints,
 
    QVector<double> tdata;
    QVector<double> ydata;
-   QCaDataPoint point;
-   QCaDataPoint previous;
+   double previousValue = 0.0;
    bool doesPreviousExist;
    bool isFirstPoint;
    double t;
@@ -634,6 +882,10 @@ void QEStripChartItem::plotDataPoints (const QCaDataPointList& dataPoints,
    const int last  = dataPoints.indexBeforeTime (end_time, count);
    const int number = last - first + 1;
 
+   // Include the first point after the end time, if any.
+   //
+   const int lastIndex = MIN (last + 1, count - 1);
+
    // The maximum width of the chart is typically of the order of
    // 1200 pixels. No point over-plotting if we have lots of data. If
    // more that 3*chart width then start decimating.
@@ -649,21 +901,56 @@ void QEStripChartItem::plotDataPoints (const QCaDataPointList& dataPoints,
    QEStripChartNames::LinePlotModes workingPlotMode = this->linePlotMode;
    if (decimation > 1) workingPlotMode = QEStripChartNames::lpmSmooth;
 
+   // When decimating, determine which points are to be plotted.
+   //
+   QVector<int> indices;
+   const bool isDecimating = (decimation > 1) && (lastIndex > first);
+   if (isDecimating) {
+      switch (this->decimationMode) {
+         case QEStripChartNames::dmMinMax:
+            indices.reserve (4 * width + 8);
+            minMaxDecimate (indices, dataPoints, first, lastIndex,
+                            start_time.getNSecsSinceEpoch (),
+                            end_time.getNSecsSinceEpoch (), width);
+            break;
+
+         case QEStripChartNames::dmLttb:
+            indices.reserve (2 * width + 8);
+            lttbDecimate (indices, dataPoints, first, lastIndex, 2 * width);
+            break;
+
+         case QEStripChartNames::dmStride:
+         default:
+            indices.reserve ((number / decimation) + 2);
+            strideDecimate (indices, first, lastIndex, decimation);
+            break;
+      }
+   }
+
+   const int plotCount = isDecimating ? indices.count () : (count - first);
+
    // Reserve required number of draw points up front.
    //
-   int drawPoints = (number / decimation) + 1;
+   int drawPoints = (isDecimating ? plotCount : number) + 1;
    if (workingPlotMode == QEStripChartNames::lpmRectangular) {
      drawPoints = 2*drawPoints;
    }
    tdata.reserve (drawPoints);
    ydata.reserve (drawPoints);
 
-   for (int j = first; j < count; j += decimation) {
-      point = dataPoints.value (j);
+   // Use the list's packed time and value accessors directly - avoids the
+   // construction of a QCaDataPoint for each point.
+   //
+   const qint64 endNSecs = end_time.getNSecsSinceEpoch ();
+
+   for (int s = 0; s < plotCount; s++) {
+      const int j = isDecimating ? indices.at (s) : (first + s);
+      const double value = dataPoints.getValue (j);
+      const bool isDisplayable = dataPoints.isDisplayable (j);
 
       // Calculate the time of this point (in seconds) relative to the end of the chart.
       //
-      t = end_time.secondsTo (point.datetime);
+      t = double (dataPoints.getNSecsSinceEpoch (j) - endNSecs) * 1.0e-9;
 
       if (t < -duration) {
          // Point time is before current time range of the chart.
@@ -671,11 +958,11 @@ void QEStripChartItem::plotDataPoints (const QCaDataPointList& dataPoints,
          // Just save this point. Last time it is saved it will be the
          // pen-ultimate point before the chart start time.
          //
-         previous = point;
+         previousValue = value;
 
          // Only "exists" if plottable.
          //
-         doesPreviousExist = point.isDisplayable ();  // (previous.alarm.isInvalid () == false);
+         doesPreviousExist = isDisplayable;
 
       }
       else if ((t >= -duration) && (t <= 0.0)) {
@@ -683,20 +970,20 @@ void QEStripChartItem::plotDataPoints (const QCaDataPointList& dataPoints,
          //
          // Is it a valid point - can we sensible plot it?
          //
-         if (point.isDisplayable ()) {
+         if (isDisplayable) {
             // Yes we can.
             //
             if (!this->firstPointIsDefined) {
                this->firstPointIsDefined = true;
-               this->firstPoint = point;
+               this->firstPoint = dataPoints.value (j);
             }
 
             // start edge effect required?
             //
             if (isFirstPoint && doesPreviousExist) {
                 tdata.append (PLOT_T (-duration));
-                ydata.append (PLOT_Y (previous.value));
-                plottedTrackRange.merge (previous.value);
+                ydata.append (PLOT_Y (previousValue));
+                plottedTrackRange.merge (previousValue);
             }
 
             if (workingPlotMode == QEStripChartNames::lpmRectangular) {
@@ -709,8 +996,8 @@ void QEStripChartItem::plotDataPoints (const QCaDataPointList& dataPoints,
             }
 
             tdata.append (PLOT_T (t));
-            ydata.append (PLOT_Y (point.value));
-            plottedTrackRange.merge (point.value);
+            ydata.append (PLOT_Y (value));
+            plottedTrackRange.merge (value);
 
          } else {
             // plot what we have so far (need at least 2 points).
@@ -737,7 +1024,7 @@ void QEStripChartItem::plotDataPoints (const QCaDataPointList& dataPoints,
          // Point time is after current plot time of the chart.
          // This this point is dispalyable, then plot upto the edge of the chart.
          //
-         extendToEnd = point.isDisplayable ();;
+         extendToEnd = isDisplayable;
          break;
       }
    }
@@ -746,8 +1033,8 @@ void QEStripChartItem::plotDataPoints (const QCaDataPointList& dataPoints,
    //
    if (isFirstPoint && doesPreviousExist) {
        tdata.append (PLOT_T (-duration));
-       ydata.append (PLOT_Y (previous.value));
-       plottedTrackRange.merge (previous.value);
+       ydata.append (PLOT_Y (previousValue));
+       plottedTrackRange.merge (previousValue);
    }
 
    // Plot what we have accumulated.
@@ -1031,6 +1318,10 @@ void QEStripChartItem::setDataValue (const QVariant& value, QCaAlarmInfo& alarm,
       // be selected buy the user.
       //
       input = list.value (0);
+   } else if (QEVectorVariants::isVectorVariant (value)) {
+      // Ditto own vector variants.
+      //
+      input = QEVectorVariants::getVariantValue (value, 0, QVariant ());
    } else {
       input = value;  // use as is
    }
@@ -1080,11 +1371,17 @@ void QEStripChartItem::setArchiveData (const QObject* userData, const bool okay,
 
       this->dashExists = false;
 
-      // Clear any existing data and save new data
+      // Clear any existing data and save new data, unless earlier batches
+      // of this read are held, in which case add the remaining points.
       // Maybe would could/should do some stiching together
       //
-      this->historicalTimeDataPoints.clear ();
-      this->historicalTimeDataPoints = archiveData;
+      if (this->archiveBatchesReceived) {
+         this->historicalTimeDataPoints.append (archiveData);
+      } else {
+         this->historicalTimeDataPoints.clear ();
+         this->historicalTimeDataPoints = archiveData;
+      }
+      this->archiveBatchesReceived = false;
 
       // Determine number of valid points, and generate user information message.
       //
@@ -1195,10 +1492,45 @@ void QEStripChartItem::setArchiveData (const QObject* userData, const bool okay,
       this->chart->setReplotIsRequired ();
 
    } else {
+      if (userData == this) this->archiveBatchesReceived = false;
       this->chart->setReadOut (supplementary);
    }
 }
 
+//------------------------------------------------------------------------------
+// A batch of a large read - display it now. The final setArchiveData call
+// adds any remaining points and removes the overlap with the real time data.
+//
+void QEStripChartItem::appendArchiveData (const QObject* userData,
+                                          const QCaDataPointList& archiveData,
+                                          const QString& pvName)
+{
+   if (userData != this) return;
+
+   if (!this->archiveBatchesReceived) {
+      this->historicalTimeDataPoints.clear ();
+      this->historicalMinMax.clear ();
+      this->dashExists = false;
+      this->archiveBatchesReceived = true;
+   }
+
+   this->historicalTimeDataPoints.append (archiveData);
+
+   const int count = archiveData.count ();
+   for (int j = 0; j < count; j++) {
+      const QCaDataPoint point = archiveData.value (j);
+      if (point.isDisplayable ()) {
+         this->historicalMinMax.merge (point.value);
+      }
+   }
+
+   QString message = QString ("%1: %2 points received")
+         .arg (pvName).arg (this->historicalTimeDataPoints.count ());
+   this->chart->setReadOut (message);
+
+   this->chart->setReplotIsRequired ();
+}
+
 //------------------------------------------------------------------------------
 //
 void QEStripChartItem::readArchive ()
@@ -1738,6 +2070,7 @@ void QEStripChartItem::contextMenuRequested (const QPoint & pos)
       this->inUseMenu->setArchiveReadHow (this->getArchiveReadHow ());
       this->inUseMenu->setLineDrawMode (this->getLineDrawMode ());
       this->inUseMenu->setLinePlotMode (this->getLinePlotMode ());
+      this->inUseMenu->setDecimationMode (this->getDecimationMode ());
       this->inUseMenu->exec (golbalPos, 0);
    } else {
       this->emptyMenu->setPredefinedNames (chart->getPredefinedPVNameList ());
@@ -1940,6 +2273,21 @@ void QEStripChartItem::contextMenuSelected (const QEStripChartNames::ContextMenu
          this->chart->setReplotIsRequired ();
          break;
 
+      case QEStripChartNames::SCCM_DECIMATE_STRIDE:
+         this->decimationMode = QEStripChartNames::dmStride;
+         this->chart->setReplotIsRequired ();
+         break;
+
+      case QEStripChartNames::SCCM_DECIMATE_MIN_MAX:
+         this->decimationMode = QEStripChartNames::dmMinMax;
+         this->chart->setReplotIsRequired ();
+         break;
+
+      case QEStripChartNames::SCCM_DECIMATE_LTTB:
+         this->decimationMode = QEStripChartNames::dmLttb;
+         this->chart->setReplotIsRequired ();
+         break;
+
       case QEStripChartNames::SCCM_ARCH_LINEAR:
          this->archiveReadHow = QEArchiveInterface::Linear;
          break;
@@ -2026,6 +2374,11 @@ void QEStripChartItem::saveConfiguration (PMElement& parentElement)
                                                    "LinePlotModes", this->getLinePlotMode());
       pvElement.addValue ("linePlotMode", linePlotModeStr);
 
+      QString decimationModeStr;
+      decimationModeStr = QEUtilities::enumToString (QEStripChartNames::staticMetaObject,
+                                                     "DecimationModes", this->getDecimationMode());
+      pvElement.addValue ("decimationMode", decimationModeStr);
+
       QString archiverHowStr;
       archiverHowStr = QEUtilities::enumToString (QEArchiveInterface::staticMetaObject,
                                                   "How", this->getArchiveReadHow());
@@ -2098,6 +2451,17 @@ void QEStripChartItem::restoreConfiguration (PMElement& parentElement)
          }
       }
 
+      QString decimationModeStr;
+      status = pvElement.getValue ("decimationMode", decimationModeStr);
+      if (status) {
+         int dm;
+         dm = QEUtilities::stringToEnum (QEStripChartNames::staticMetaObject,
+                                         "DecimationModes", decimationModeStr, &status);
+         if (status) {
+            this->decimationMode = QEStripChartNames::DecimationModes (dm);
+         }
+      }
+
       QString archiverHowStr;
       status = pvElement.getValue ("archiverHow", archiverHowStr);
       if (status) {
@@ -94,6 +94,7 @@ public:
    QEArchiveInterface::How getArchiveReadHow () const { return this->archiveReadHow; }
    QEStripChartNames::LineDrawModes getLineDrawMode () const { return this->lineDrawMode; }
    QEStripChartNames::LinePlotModes getLinePlotMode () const { return this->linePlotMode; }
+   QEStripChartNames::DecimationModes getDecimationMode () const { return this->decimationMode; }
 
    void setAliasName (const QString& aliasName);
    QString getAliasName () const;
@@ -189,6 +190,7 @@ private:
    QEArchiveInterface::How archiveReadHow;
    QEStripChartNames::LineDrawModes lineDrawMode;
    QEStripChartNames::LinePlotModes linePlotMode;
+   QEStripChartNames::DecimationModes decimationMode;
 
    QString aliasName;
    QString description;
@@ -199,6 +201,7 @@ private:
    QCaDataPointList realTimeDataPoints;
    QEDisplayRanges historicalMinMax;
    QEDisplayRanges realTimeMinMax;
+   bool archiveBatchesReceived;   // historical data holds batches of the current read
 
    // Used to specify dash line joining historical to live data.
    //
@@ -257,6 +260,8 @@ private slots:
 
    void setArchiveData (const QObject* userData, const bool okay, const QCaDataPointList& archiveData,
                         const QString& pvName, const QString& supplementary);
+   void appendArchiveData (const QObject* userData, const QCaDataPointList& archiveData,
+                           const QString& pvName);
 
    void letterButtonClicked (bool checked);
    void contextMenuRequested (const QPoint & pos);
@@ -109,6 +109,17 @@ public:
 
    Q_ENUM (LinePlotModes)
 
+   // Defines how points are selected when there are more points than can be
+   // sensibly plotted, i.e. more than approx. 3 points per pixel.
+   //
+   enum DecimationModes {
+      dmStride,        // plot every n-th point - fast, but may miss transients
+      dmMinMax,        // plot first, min, max and last point per pixel (M4)
+      dmLttb           // largest triangle three buckets - preserves visual shape
+   };
+
+   Q_ENUM (DecimationModes)
+
    // IDs for all menu options
    // Each menu option has a unique ID across all menus
    // These IDs are in addition to standard context menu IDs and so start after
@@ -145,6 +156,9 @@ public:
       SCCM_PLOT_SMOOTH,
       SCCM_PLOT_SERVER_TIME,
       SCCM_PLOT_CLIENT_TIME,
+      SCCM_DECIMATE_STRIDE,
+      SCCM_DECIMATE_MIN_MAX,
+      SCCM_DECIMATE_LTTB,
       //
       SCCM_ARCH_LINEAR,
       SCCM_ARCH_PLOTBIN,
@@ -197,6 +211,7 @@ Q_DECLARE_METATYPE (QEStripChartNames::StateModes)
 Q_DECLARE_METATYPE (QEStripChartNames::YScaleModes)
 Q_DECLARE_METATYPE (QEStripChartNames::LineDrawModes)
 Q_DECLARE_METATYPE (QEStripChartNames::LinePlotModes)
+Q_DECLARE_METATYPE (QEStripChartNames::DecimationModes)
 #endif
 
 #endif   // QE_STRIPCHART_NAMES_H
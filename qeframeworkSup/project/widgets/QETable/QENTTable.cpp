@@ -35,6 +35,7 @@
 #include <QEFloating.h>
 #include <QHeaderView>
 #include <QENTTableData.h>
+#include <QENTTableModel.h>
 
 #define DEBUG qDebug () << "QENTTable" << __LINE__ << __FUNCTION__ << "  "
 
@@ -74,9 +75,12 @@ void QENTTable::commonConstruct ()
    this->tableData = new QENTTableData ();
    this->tableData->clear();
 
-   // Create internal widget. We always have at least one row and one col.
+   // Create internal widget and the model that presents the table data.
+   // The model reads cells directly from the table data columns.
    //
-   this->table = new QTableWidget (1, 1, this);
+   this->table = new QTableView (this);
+   this->model = new QENTTableModel (this);
+   this->table->setModel (this->model);
 
    // Copy actual widget size policy to the containing widget, then ensure
    // internal widget will expand to fill container widget.
@@ -90,7 +94,7 @@ void QENTTable::commonConstruct ()
 
    // Set default property values
    //
-   this->displayMaximum = 0x1000;
+   this->displayMaximum = 0;   // no limit
    this->selection = NULL_SELECTION;
    this->selectionChangeInhibited = false;
 
@@ -131,11 +135,11 @@ void QENTTable::commonConstruct ()
 
    // Table related signals
    //
-   QObject::connect (this->table, SIGNAL (cellClicked      (int, int)),
-                     this,        SLOT   (gridCellClicked  (int, int)));
+   QObject::connect (this->table, SIGNAL (clicked          (const QModelIndex&)),
+                     this,        SLOT   (gridCellClicked  (const QModelIndex&)));
 
-   QObject::connect (this->table, SIGNAL (cellEntered      (int, int)),
-                     this,        SLOT   (gridCellEntered  (int, int)));
+   QObject::connect (this->table, SIGNAL (entered          (const QModelIndex&)),
+                     this,        SLOT   (gridCellEntered  (const QModelIndex&)));
 
    this->table->setMouseTracking (true);   // need this for cell entered.
 
@@ -391,7 +395,7 @@ void QENTTable::resizeCoulumns ()
    int otherStuff;
    int colWidth;
 
-   count = this->table->columnCount ();
+   count = this->model->columnCount ();
    count = MAX (1, count);
 
    // Allow for side headers and scroll bar.
@@ -411,123 +415,16 @@ void QENTTable::resizeCoulumns ()
 //
 void QENTTable::populateTable ()
 {
-   if (this->isVertical ()) {
-      this->populateVerticalTable ();
-   }  else {
-      this->populateHorizontalTable ();
-   }
-   this->rePopulateData = false;
-}
-
-//------------------------------------------------------------------------------
-//
-void QENTTable::populateVerticalTable ()
-{
-   if (!this->table) return;      // sanity check
-   if (!this->tableData) return;  // sanity check
-
-   const int cols = this->tableData->getColCount ();
-   const int rows = this->tableData->getRowCount ();
-   const QStringList headers = this->tableData->getLabels();
-
-   QTableWidgetItem* item;
-
-   this->table->setColumnCount (MAX (cols, 1));
-   this->table->setRowCount (MAX (rows, 1));
-
-   for (int col = 0; col < cols; col++) {
-      // Set the title - allocate title item if needs be.
-      //
-      item = this->table->horizontalHeaderItem (col);
-      if (!item) {
-         item = new QTableWidgetItem ();
-         this->table->setHorizontalHeaderItem (col, item);
-      }
-      item->setText (headers.value (col, "-"));
-
-      QVariantList dataSet = this->tableData->getColData (col);
-
-      for (int row = 0; row < rows; row++) {
-
-         item = this->table->verticalHeaderItem (row);
-         if (!item) {
-            item = new QTableWidgetItem ();
-            this->table->setVerticalHeaderItem (row, item);
-         }
-         item->setText (QString::number(row + 1));
-
-         item = this->table->item (row, col);
-         if (!item) {
-            // We need to allocate item and insert it into the table.
-            //
-            item = new QTableWidgetItem ();
-            item->setTextAlignment (Qt::AlignRight | Qt::AlignVCenter);
-            item->setFlags (Qt::ItemIsSelectable | Qt::ItemIsEnabled);
-            this->table->setItem (row, col, item);
-         }
-
-         QVariant datum = dataSet.value (row, QVariant ("-"));
-         QString image = datum.toString ();
-         item->setText (image);
-      }
-   }
-}
-
-//------------------------------------------------------------------------------
-// keep in step with populateVerticalTable
-//
-void QENTTable::populateHorizontalTable ()
-{
-   if (!this->table) return;      // sanity check
+   if (!this->model) return;      // sanity check
    if (!this->tableData) return;  // sanity check
 
-   const int cols = this->tableData->getRowCount ();
-   const int rows = this->tableData->getColCount ();
-   const QStringList headers = this->tableData->getLabels();
-
-   QTableWidgetItem* item;
-
-   this->table->setColumnCount (MAX (cols, 1));
-   this->table->setRowCount (MAX (rows, 1));
-
-
-   for (int row = 0; row < rows; row++) {
-      // Set the title - allocate title item if needs be.
-      //
-      item = this->table->verticalHeaderItem (row);
-      if (!item) {
-         item = new QTableWidgetItem ();
-         this->table->setVerticalHeaderItem (row, item);
-      }
-      item->setText (headers.value (row, "-"));
-
-      QVariantList dataSet = this->tableData->getColData (row);
-
-      for (int col = 0; col < cols; col++) {
-
-         item = this->table->horizontalHeaderItem (col);
-         if (!item) {
-            item = new QTableWidgetItem ();
-            this->table->setHorizontalHeaderItem (col, item);
-         }
-         item->setText (QString::number(col + 1));
-
-         QTableWidgetItem* item = this->table->item (row, col);
-
-         if (!item) {
-            // We need to allocate item and insert it into the table.
-            //
-            item = new QTableWidgetItem ();
-            item->setTextAlignment (Qt::AlignRight | Qt::AlignVCenter);
-            item->setFlags (Qt::ItemIsSelectable | Qt::ItemIsEnabled);
-            this->table->setItem (row, col, item);
-         }
-
-         QVariant datum = dataSet.value (col, QVariant ("-"));
-         QString image = datum.toString ();
-         item->setText (image);
-      }
-   }
+   // The model only resets the view when the table shape changes, otherwise
+   // the view just repaints the visible cells.
+   //
+   this->model->setOrientation (this->orientation);
+   this->model->setDisplayMaximum (this->displayMaximum);
+   this->model->setTableData (*this->tableData);
+   this->rePopulateData = false;
 }
 
 //------------------------------------------------------------------------------
@@ -555,9 +452,9 @@ void QENTTable::setNewVariableName (QString variableName,
 // User has clicked on cell or used up/down/left/right key to select cell,
 // or we have programtically selected a row/coll.
 //
-void QENTTable::gridCellClicked (int row, int column)
+void QENTTable::gridCellClicked (const QModelIndex& index)
 {
-   this->selection = (this->isVertical () ? row : column);
+   this->selection = (this->isVertical () ? index.row () : index.column ());
 
    // This prevents infinite looping in the case of cyclic connections.
    //
@@ -568,7 +465,7 @@ void QENTTable::gridCellClicked (int row, int column)
 
 //------------------------------------------------------------------------------
 //
-void QENTTable::gridCellEntered (int, int)
+void QENTTable::gridCellEntered (const QModelIndex&)
 {
    // place holder
    // qDebug () << __FUNCTION__ << row << column;
@@ -620,7 +517,7 @@ int QENTTable::getSelection () const {
 //
 void QENTTable::setDisplayMaximum (const int displayMaximumIn)
 {
-   int temp = LIMIT (displayMaximumIn, 1, 0x10000);
+   int temp = MAX (displayMaximumIn, 0);   // 0 is no limit
 
    if (this->displayMaximum != temp) {
       this->displayMaximum = temp;
@@ -33,7 +33,7 @@
 #include <QString>
 #include <QStringList>
 #include <QSize>
-#include <QTableWidget>
+#include <QTableView>
 #include <QTimer>
 #include <QVector>
 
@@ -57,7 +57,8 @@
    and standard properties. QEAbstractWidget provides all standard properties.
  */
 
-class QENTTableData;  //  differed
+class QENTTableData;   //  differed
+class QENTTableModel;  //  differed
 
 class QE_FRAMEWORK_LIBRARY_SHARED_EXPORT QENTTable :
       public QEAbstractWidget,
@@ -86,8 +87,10 @@ public:
    ///
    Q_PROPERTY (int colWidthMinimum    READ getColumnWidthMinimum   WRITE setColumnWidthMinimum)
 
-   /// The maximum number of array elements that will be displayed irrespective of the
-   /// number of elements that the EPICS variable contains. Defaults to 4096.
+   /// The maximum number of table rows that will be displayed irrespective of the
+   /// number of rows that the EPICS variable contains. Rows are fetched by the view
+   /// on demand, so large tables need not be limited. Zero means no limit, which is
+   /// the default. When rows are hidden, the row header tool tip says so.
    ///
    Q_PROPERTY (int displayMaximum     READ getDisplayMaximum       WRITE setDisplayMaximum)
 
@@ -195,8 +198,6 @@ private:
    void resizeCoulumns ();    // Resizes colums to fit available space
 
    void populateTable ();             //
-   void populateVerticalTable ();     //
-   void populateHorizontalTable ();   //
 
    // Provides consistant interpretation of variableIndex.
    // Must be consistent with variableIndex allocation in the contructor.
@@ -204,7 +205,8 @@ private:
    int slotOf  (const unsigned int vi) { return int (vi); }
 
    QENTTableData* tableData;
-   QTableWidget* table;         // internal widget
+   QTableView* table;           // internal widget
+   QENTTableModel* model;       // presents tableData to the internal widget
    QHBoxLayout* layout;         // holds the internal widget - any layout type will do
    QTimer* rePopulateTimer;
    int displayMaximum;
@@ -229,8 +231,8 @@ private slots:
                           QCaDateTime& timeStamp,
                           const unsigned int& variableIndex);
 
-   void gridCellClicked (int row, int column);
-   void gridCellEntered (int row, int column);
+   void gridCellClicked (const QModelIndex& index);
+   void gridCellEntered (const QModelIndex& index);
 
    void timeout ();
 };
@@ -0,0 +1,275 @@
+/*  QENTTableModel.cpp
+ *
+ *  This file is part of the EPICS QT Framework, initially developed at the
+ *  Australian Synchrotron.
+ *
+ *  Copyright (C) 2024 The EPICS QT Framework contributors.
+ *
+ *  The EPICS QT Framework is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  The EPICS QT Framework is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with the EPICS QT Framework.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "QENTTableModel.h"
+#include <QDebug>
+#include <QECommon.h>
+
+#define DEBUG qDebug () << "QENTTableModel" << __LINE__ << __FUNCTION__ << "  "
+
+// The number of NTTable rows made available to the view per fetch.
+//
+#define FETCH_BATCH_SIZE  0x400
+
+//------------------------------------------------------------------------------
+//
+QENTTableModel::QENTTableModel (QObject* parent) : QAbstractTableModel (parent)
+{
+   this->orientation = Qt::Vertical;
+   this->displayMaximum = 0;    // no limit
+   this->fetchedRows = 0;
+}
+
+//------------------------------------------------------------------------------
+//
+QENTTableModel::~QENTTableModel () { }
+
+//------------------------------------------------------------------------------
+//
+void QENTTableModel::setTableData (const QENTTableData& tableDataIn)
+{
+   const bool sameShape =
+         (tableDataIn.getRowCount () == this->tableData.getRowCount ()) &&
+         (tableDataIn.getColCount () == this->tableData.getColCount ()) &&
+         (tableDataIn.getLabels ()   == this->tableData.getLabels ());
+
+   if (sameShape) {
+      // Same row count, so the fetched row count remains valid.
+      //
+      this->tableData = tableDataIn;   // shallow copy
+
+      const int nr = this->rowCount ();
+      const int nc = this->columnCount ();
+      if ((nr > 0) && (nc > 0)) {
+         emit this->dataChanged (this->index (0, 0), this->index (nr - 1, nc - 1));
+      }
+   } else {
+      this->beginResetModel ();
+      this->tableData = tableDataIn;
+      this->fetchedRows = MIN (this->availableRowCount (), FETCH_BATCH_SIZE);
+      this->endResetModel ();
+   }
+}
+
+//------------------------------------------------------------------------------
+//
+QENTTableData QENTTableModel::getTableData () const
+{
+   return this->tableData;
+}
+
+//------------------------------------------------------------------------------
+//
+void QENTTableModel::setOrientation (const Qt::Orientation orientationIn)
+{
+   if (this->orientation != orientationIn) {
+      this->beginResetModel ();
+      this->orientation = orientationIn;
+      this->endResetModel ();
+   }
+}
+
+//------------------------------------------------------------------------------
+//
+Qt::Orientation QENTTableModel::getOrientation () const
+{
+   return this->orientation;
+}
+
+//------------------------------------------------------------------------------
+//
+void QENTTableModel::setDisplayMaximum (const int displayMaximumIn)
+{
+   const int temp = MAX (0, displayMaximumIn);
+   if (this->displayMaximum != temp) {
+      this->beginResetModel ();
+      this->displayMaximum = temp;
+      this->fetchedRows = MIN (this->availableRowCount (), MAX (this->fetchedRows, FETCH_BATCH_SIZE));
+      this->endResetModel ();
+   }
+}
+
+//------------------------------------------------------------------------------
+//
+int QENTTableModel::getDisplayMaximum () const
+{
+   return this->displayMaximum;
+}
+
+//------------------------------------------------------------------------------
+//
+bool QENTTableModel::isVertical () const
+{
+   return (this->orientation != Qt::Horizontal);
+}
+
+//------------------------------------------------------------------------------
+//
+int QENTTableModel::availableRowCount () const
+{
+   const int rows = this->tableData.getRowCount ();
+   return (this->displayMaximum > 0) ? MIN (rows, this->displayMaximum) : rows;
+}
+
+//------------------------------------------------------------------------------
+//
+int QENTTableModel::dataRowCount () const
+{
+   return MIN (this->fetchedRows, this->availableRowCount ());
+}
+
+//------------------------------------------------------------------------------
+// True when the display maximum hides some NTTable rows.
+//
+bool QENTTableModel::isTruncated () const
+{
+   return this->availableRowCount () < this->tableData.getRowCount ();
+}
+
+//------------------------------------------------------------------------------
+// Maps a model index to an NTTable row and column.
+//
+bool QENTTableModel::mapIndex (const QModelIndex& index, int& dataRow, int& dataCol) const
+{
+   if (!index.isValid ()) return false;
+
+   if (this->isVertical ()) {
+      dataRow = index.row ();
+      dataCol = index.column ();
+   } else {
+      dataRow = index.column ();
+      dataCol = index.row ();
+   }
+
+   return (dataRow >= 0) && (dataRow < this->dataRowCount ()) &&
+          (dataCol >= 0) && (dataCol < this->tableData.getColCount ());
+}
+
+//------------------------------------------------------------------------------
+//
+int QENTTableModel::rowCount (const QModelIndex& parent) const
+{
+   if (parent.isValid ()) return 0;   // not a tree
+   return this->isVertical () ? this->dataRowCount () : this->tableData.getColCount ();
+}
+
+//------------------------------------------------------------------------------
+//
+int QENTTableModel::columnCount (const QModelIndex& parent) const
+{
+   if (parent.isValid ()) return 0;   // not a tree
+   return this->isVertical () ? this->tableData.getColCount () : this->dataRowCount ();
+}
+
+//------------------------------------------------------------------------------
+//
+QVariant QENTTableModel::data (const QModelIndex& index, int role) const
+{
+   int dataRow;
+   int dataCol;
+
+   if (!this->mapIndex (index, dataRow, dataCol)) return QVariant ();
+
+   switch (role) {
+      case Qt::DisplayRole:
+         // Columns may be of unequal length.
+         if (dataRow >= this->tableData.getColumnLength (dataCol)) {
+            return QVariant ("-");
+         }
+         return QVariant (this->tableData.getItemText (dataRow, dataCol));
+
+      case Qt::TextAlignmentRole:
+         return QVariant (int (Qt::AlignRight | Qt::AlignVCenter));
+
+      default:
+         return QVariant ();
+   }
+}
+
+//------------------------------------------------------------------------------
+//
+QVariant QENTTableModel::headerData (int section, Qt::Orientation headerOrientation,
+                                     int role) const
+{
+   // The label header is the horizontal header when vertical, and vice versa.
+   //
+   const bool isLabelHeader = this->isVertical () ? (headerOrientation == Qt::Horizontal)
+                                                  : (headerOrientation == Qt::Vertical);
+
+   // Let the user know when rows are not shown due to the display maximum.
+   //
+   if ((role == Qt::ToolTipRole) && !isLabelHeader && this->isTruncated ()) {
+      return QVariant (QString ("Showing %1 of %2 rows (display maximum)")
+                       .arg (this->availableRowCount ())
+                       .arg (this->tableData.getRowCount ()));
+   }
+
+   if (role != Qt::DisplayRole) return QVariant ();
+
+   if (isLabelHeader) {
+      return QVariant (this->tableData.getLabels ().value (section, "-"));
+   } else {
+      return QVariant (QString::number (section + 1));
+   }
+}
+
+//------------------------------------------------------------------------------
+//
+Qt::ItemFlags QENTTableModel::flags (const QModelIndex& index) const
+{
+   if (!index.isValid ()) return Qt::NoItemFlags;
+   return Qt::ItemIsSelectable | Qt::ItemIsEnabled;
+}
+
+//------------------------------------------------------------------------------
+//
+bool QENTTableModel::canFetchMore (const QModelIndex& parent) const
+{
+   if (parent.isValid ()) return false;   // not a tree
+   return this->fetchedRows < this->availableRowCount ();
+}
+
+//------------------------------------------------------------------------------
+// Called by the view as it scrolls towards the end of the fetched rows.
+//
+void QENTTableModel::fetchMore (const QModelIndex& parent)
+{
+   if (parent.isValid ()) return;
+
+   const int first = this->fetchedRows;
+   const int number = MIN (this->availableRowCount () - first, FETCH_BATCH_SIZE);
+   if (number <= 0) return;
+
+   // NTTable rows are model columns when horizontal.
+   //
+   if (this->isVertical ()) {
+      this->beginInsertRows (QModelIndex (), first, first + number - 1);
+      this->fetchedRows += number;
+      this->endInsertRows ();
+   } else {
+      this->beginInsertColumns (QModelIndex (), first, first + number - 1);
+      this->fetchedRows += number;
+      this->endInsertColumns ();
+   }
+}
+
+// end
@@ -0,0 +1,84 @@
+/*  QENTTableModel.h
+ *
+ *  This file is part of the EPICS QT Framework, initially developed at the
+ *  Australian Synchrotron.
+ *
+ *  Copyright (C) 2024 The EPICS QT Framework contributors.
+ *
+ *  The EPICS QT Framework is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  The EPICS QT Framework is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with the EPICS QT Framework.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef QE_NT_TABLE_MODEL_H
+#define QE_NT_TABLE_MODEL_H
+
+#include <QAbstractTableModel>
+#include <QVariant>
+#include <QENTTableData.h>
+#include <QEFrameworkLibraryGlobal.h>
+
+/// A read only table model that presents QENTTableData. Cells are read directly
+/// from the typed table columns when requested by the view, so only visible cells
+/// are ever converted.
+///
+/// In the vertical orientation each NTTable column is a model column; in the
+/// horizontal orientation the table is transposed. NTTable rows are fetched by
+/// the view on demand in batches, so large tables are not truncated. The number of
+/// rows presented may optionally be limited by the display maximum (0 is no limit).
+///
+class QE_FRAMEWORK_LIBRARY_SHARED_EXPORT QENTTableModel : public QAbstractTableModel
+{
+   Q_OBJECT
+public:
+   explicit QENTTableModel (QObject* parent = 0);
+   ~QENTTableModel ();
+
+   // Updates the table data. When the shape of the table and the labels are
+   // unchanged, the view is just notified that the data has changed, otherwise
+   // the model is reset.
+   //
+   void setTableData (const QENTTableData& tableData);
+   QENTTableData getTableData () const;
+
+   void setOrientation (const Qt::Orientation orientation);
+   Qt::Orientation getOrientation () const;
+
+   void setDisplayMaximum (const int displayMaximum);
+   int getDisplayMaximum () const;
+
+   // QAbstractTableModel overrides.
+   //
+   int rowCount (const QModelIndex& parent = QModelIndex ()) const;
+   int columnCount (const QModelIndex& parent = QModelIndex ()) const;
+   QVariant data (const QModelIndex& index, int role = Qt::DisplayRole) const;
+   QVariant headerData (int section, Qt::Orientation orientation,
+                        int role = Qt::DisplayRole) const;
+   Qt::ItemFlags flags (const QModelIndex& index) const;
+   bool canFetchMore (const QModelIndex& parent) const;
+   void fetchMore (const QModelIndex& parent);
+
+private:
+   bool isVertical () const;
+   int availableRowCount () const;   // number of NTTable rows that may be presented
+   int dataRowCount () const;        // number of NTTable rows presented (fetched)
+   bool isTruncated () const;
+   bool mapIndex (const QModelIndex& index, int& dataRow, int& dataCol) const;
+
+   QENTTableData tableData;
+   Qt::Orientation orientation;
+   int displayMaximum;
+   int fetchedRows;
+};
+
+#endif // QE_NT_TABLE_MODEL_H
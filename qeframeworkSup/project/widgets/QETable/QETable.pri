@@ -27,11 +27,13 @@
 
 HEADERS += \
     widgets/QETable/QETable.h \
-    widgets/QETable/QENTTable.h
+    widgets/QETable/QENTTable.h \
+    widgets/QETable/QENTTableModel.h
 
 SOURCES += \
     widgets/QETable/QETable.cpp \
-    widgets/QETable/QENTTable.cpp
+    widgets/QETable/QENTTable.cpp \
+    widgets/QETable/QENTTableModel.cpp
 
 INCLUDEPATH += \
     widgets/QETable
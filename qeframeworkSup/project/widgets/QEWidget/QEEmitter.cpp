@@ -30,6 +30,7 @@
 
 #include <QECommon.h>
 #include <QCaObject.h>
+#include <QEVectorVariants.h>
 #include <QEWidget.h>
 
 #include <QEEmitter.h>
@@ -166,6 +167,17 @@ void QEEmitter::emitDbValueChangedPrivate (const bool useFormmattedText,
       // Convert this array element as a scalar update.
       //
       value = value.toList().value (ai);
+
+   } else if (QEVectorVariants::isVectorVariant (value)) {
+      // Ditto for own vector variants.
+      //
+      int ai = qca->getArrayIndex ();
+      if (ai < 0 || ai >= QEVectorVariants::vectorCount (value)) {
+         // out of range
+         return;
+      }
+
+      value = QEVectorVariants::getVariantValue (value, ai, QVariant ());
    }
 
    if (this->filter [fkUpdateEvent]) {
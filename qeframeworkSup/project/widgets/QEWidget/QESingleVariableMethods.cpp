@@ -42,6 +42,11 @@ QESingleVariableMethods::QESingleVariableMethods
 {
    this->elementsRequired = REQUIRED_ELEMENTS_UNSPECIFIED;
    this->arrayIndex = 0;
+   this->absoluteDeadband = 0.0;
+   this->relativeDeadband = 0.0;
+   this->autoDeadband = false;
+   this->minimumUpdateInterval = 0;
+   this->pvRequest = "";
    this->vnpm.setVariableIndex (variableIndex);
 }
 
@@ -154,6 +159,101 @@ int QESingleVariableMethods::getArrayIndex () const
     return this->arrayIndex;
 }
 
+//------------------------------------------------------------------------------
+// Deadbands do not require a re-connection, just apply to any existing qca object.
+//
+void QESingleVariableMethods::setAbsoluteDeadband (const double deadband)
+{
+   this->absoluteDeadband = MAX (0.0, deadband);
+
+   const unsigned int pvIndex = this->vnpm.getVariableIndex();
+   qcaobject::QCaObject* qca = this->owner->getQcaItem (pvIndex);
+   if (qca) qca->setAbsoluteDeadband (this->absoluteDeadband);
+}
+
+//------------------------------------------------------------------------------
+//
+double QESingleVariableMethods::getAbsoluteDeadband () const
+{
+   return this->absoluteDeadband;
+}
+
+//------------------------------------------------------------------------------
+//
+void QESingleVariableMethods::setRelativeDeadband (const double percent)
+{
+   this->relativeDeadband = MAX (0.0, percent);
+
+   const unsigned int pvIndex = this->vnpm.getVariableIndex();
+   qcaobject::QCaObject* qca = this->owner->getQcaItem (pvIndex);
+   if (qca) qca->setRelativeDeadband (this->relativeDeadband);
+}
+
+//------------------------------------------------------------------------------
+//
+double QESingleVariableMethods::getRelativeDeadband () const
+{
+   return this->relativeDeadband;
+}
+
+//------------------------------------------------------------------------------
+//
+void QESingleVariableMethods::setAutoDeadband (const bool autoDeadbandIn)
+{
+   this->autoDeadband = autoDeadbandIn;
+
+   const unsigned int pvIndex = this->vnpm.getVariableIndex();
+   qcaobject::QCaObject* qca = this->owner->getQcaItem (pvIndex);
+   if (qca) qca->setAutoDeadband (this->autoDeadband);
+}
+
+//------------------------------------------------------------------------------
+//
+bool QESingleVariableMethods::getAutoDeadband () const
+{
+   return this->autoDeadband;
+}
+
+//------------------------------------------------------------------------------
+//
+void QESingleVariableMethods::setMinimumUpdateInterval (const int interval)
+{
+   this->minimumUpdateInterval = MAX (0, interval);
+
+   const unsigned int pvIndex = this->vnpm.getVariableIndex();
+   qcaobject::QCaObject* qca = this->owner->getQcaItem (pvIndex);
+   if (qca) qca->setMinimumUpdateInterval (this->minimumUpdateInterval);
+}
+
+//------------------------------------------------------------------------------
+//
+int QESingleVariableMethods::getMinimumUpdateInterval () const
+{
+   return this->minimumUpdateInterval;
+}
+
+//------------------------------------------------------------------------------
+//
+void QESingleVariableMethods::setPvRequest (const QString& pvRequestIn)
+{
+   const QString previous = this->pvRequest;
+   this->pvRequest = pvRequestIn.trimmed ();
+
+   // Has there been an actual change of value.
+   //
+   if (this->pvRequest != previous) {
+      const unsigned int pvIndex = this->vnpm.getVariableIndex();
+      this->owner->reestablishConnection (pvIndex);
+   }
+}
+
+//------------------------------------------------------------------------------
+//
+QString QESingleVariableMethods::getPvRequest () const
+{
+   return this->pvRequest;
+}
+
 //------------------------------------------------------------------------------
 //
 void QESingleVariableMethods::connectNewVariableNameProperty (const char* useNameSlot)
@@ -177,6 +277,13 @@ void QESingleVariableMethods::setSingleVariableQCaProperties (qcaobject::QCaObje
          if (this->elementsRequired != REQUIRED_ELEMENTS_UNSPECIFIED) {
             qca->setRequestedElementCount (this->elementsRequired);
          }
+         qca->setAbsoluteDeadband (this->absoluteDeadband);
+         qca->setRelativeDeadband (this->relativeDeadband);
+         qca->setAutoDeadband (this->autoDeadband);
+         qca->setMinimumUpdateInterval (this->minimumUpdateInterval);
+         if (!this->pvRequest.isEmpty ()) {
+            qca->setPvRequest (this->pvRequest);
+         }
       } else {
          DEBUG << "variable index mismatch qca:" << qca->getVariableIndex ()
                << "  property name:" <<  pvIndex;
@@ -47,6 +47,11 @@ class QEWidget;   // differed
 //   QString variableSubstitutions
 //   int elementsRequired
 //   int arrayIndex
+//   double absoluteDeadband
+//   double relativeDeadband
+//   bool autoDeadband
+//   int minimumUpdateInterval
+//   QString pvRequest
 //
 // Use of this class by inheritance does not preclude a QE widget have more than one variable.
 // Also a second, or third, variable may be manged by adding additional instance(s) of this
@@ -109,6 +114,41 @@ public:
    ///
    int getArrayIndex () const;
 
+   /// Property access functions for the #absoluteDeadband property. Scalar numeric
+   /// updates that differ from the last emitted value by no more than this amount are
+   /// not delivered to the widget. Default is 0.0, i.e. no deadband.
+   ///
+   void setAbsoluteDeadband (const double deadband);
+   double getAbsoluteDeadband () const;
+
+   /// Property access functions for the #relativeDeadband property, expressed as a
+   /// percentage of the last emitted value. Default is 0.0, i.e. no deadband.
+   ///
+   void setRelativeDeadband (const double percent);
+   double getRelativeDeadband () const;
+
+   /// Property access functions for the #autoDeadband property. When true, the deadband
+   /// is derived from the widget's string formatting precision (where applicable), such
+   /// that changes that are not visible are not delivered. Default is false.
+   ///
+   void setAutoDeadband (const bool autoDeadband);
+   bool getAutoDeadband () const;
+
+   /// Property access functions for the #minimumUpdateInterval property (mSec).
+   /// Updates are delivered no more often than this, the latest value wins.
+   /// Default is 0, i.e. no minimum.
+   ///
+   void setMinimumUpdateInterval (const int interval);
+   int getMinimumUpdateInterval () const;
+
+   /// Property access functions for the #pvRequest property (PV Access only), e.g.
+   /// "field(value,alarm,timeStamp)". When specified, this overrides any request
+   /// specified as part of the variable name. Default is empty.
+   /// As with #elementsRequired, a change re-establishes the connection.
+   ///
+   void setPvRequest (const QString& pvRequest);
+   QString getPvRequest () const;
+
    /// Connects internal variable name property manager's newVariableNameProperty signal
    /// to the specified slot.
    ///
@@ -125,7 +165,7 @@ public:
    //
    // It also does
    //    qca->setRequestedElementCount (this->elementsRequired);
-   // if needs be.
+   // if needs be, and applies the deadband and pv request settings.
    //
    // The QCaObjects are destroyed and re-created as the name/substitution values change
    // so the array index must be re-applied each time the QCaObjects is created.
@@ -136,6 +176,11 @@ private:
    QEWidget* owner;
    int elementsRequired;                  // defaults to 0, i.e. not specified
    int arrayIndex;                        // defaults to 0, restricted to >= 0
+   double absoluteDeadband;               // defaults to 0.0, i.e. none
+   double relativeDeadband;               // percent, defaults to 0.0, i.e. none
+   bool autoDeadband;                     // defaults to false
+   int minimumUpdateInterval;             // mSec, defaults to 0, i.e. none
+   QString pvRequest;                     // defaults to empty, i.e. as per variable name
    QCaVariableNamePropertyManager vnpm;
 };
 
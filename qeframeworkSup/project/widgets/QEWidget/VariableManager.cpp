@@ -44,6 +44,7 @@ VariableManager::VariableManager()
     // This will be corrected when the first variable is declared
     numVariables = 0;
     qcaItem = 0;
+    maximumUpdateRate = 0.0;
 }
 
 //------------------------------------------------------------------------------
@@ -155,6 +156,7 @@ qcaobject::QCaObject* VariableManager::createVariable( unsigned int variableInde
         if( qcaItem[variableIndex] ) {
 
             qcaItem[variableIndex]->setUserMessage( (UserMessage*)this );
+            applyMaximumUpdateRate( qcaItem[variableIndex] );
 
             if( do_subscribe ) {
                 qcaItem[variableIndex]->subscribe();
@@ -276,6 +278,40 @@ void VariableManager::readNow()
     }
 }
 
+//------------------------------------------------------------------------------
+// Set the maximum update rate for all variables managed on behalf of the widget.
+// This applies to the current QCaObjects (if any) as well as any created later.
+//
+void VariableManager::setMaximumUpdateRate( const double rate )
+{
+    maximumUpdateRate = rate >= 0.0 ? rate : 0.0;
+
+    for( unsigned int i = 0; i < numVariables; i++ ) {
+        applyMaximumUpdateRate( getQcaItem( i ) );
+    }
+}
+
+//------------------------------------------------------------------------------
+//
+double VariableManager::getMaximumUpdateRate() const
+{
+    return maximumUpdateRate;
+}
+
+//------------------------------------------------------------------------------
+// A rate of zero means the QCaObject uses the application wide default.
+//
+void VariableManager::applyMaximumUpdateRate( qcaobject::QCaObject* qca ) const
+{
+    if( !qca ) return;
+
+    if( maximumUpdateRate > 0.0 ) {
+        qca->setMaximumUpdateRate( maximumUpdateRate );
+    } else {
+        qca->setMaximumUpdateRate( qcaobject::QCaObject::getDefaultMaximumUpdateRate() );
+    }
+}
+
 //------------------------------------------------------------------------------
 // Provides default implementation of writeNow.
 //
@@ -132,6 +132,15 @@ public:
     /// UI loader.
     int* getConnectedCountRef() const;
 
+    /// Set the maximum rate (Hz) at which data updates are delivered to the widget.
+    /// Faster updates are coalesced - the latest value wins. Alarm and connection
+    /// changes are always delivered. Zero means use the application default.
+    /// This applies to all variables managed on behalf of the widget.
+    void setMaximumUpdateRate( const double rate );
+
+    /// Get the maximum update rate (Hz). Zero means use the application default.
+    double getMaximumUpdateRate() const;
+
 
 protected:
     void setNumVariables( unsigned int numVariablesIn );                        ///< Set the number of variables that will stream data updates to the widget. Default of 1 if not called.
@@ -153,6 +162,8 @@ protected:
 private:
     unsigned int numVariables;       // The number of process variables that will be managed for the QE widgets.
     qcaobject::QCaObject** qcaItem;  // CA access - provides a stream of updates. One for each variable name used by the QE widgets
+    double maximumUpdateRate;        // Maximum update rate (Hz) applied to each QCaObject, 0 means use application default
+    void applyMaximumUpdateRate( qcaobject::QCaObject* qca ) const;
 };
 
 #endif // QE_VARIABLE_MANAGER_H